@@ -86,7 +86,10 @@ public:
  *
  * This example parses a dimacs CNF file in which
  * the constraints are specified. For each line of
- * the file a clause propagator is posted.
+ * the file a clause is posted, either all clauses are propagated by
+ * a single propagator or a propagator is posted for each clause.
+ * A single propagator learns clauses from conflicts with the option
+ * "-ipl advanced".
  *
  * Format of dimacs CNF files:
  *
@@ -117,10 +120,16 @@ private:
   /// The Boolean variables
   BoolVarArray x;
 public:
+  /// Propagation to use for model
+  enum {
+    PROPAGATION_STORE,      ///< Use a single propagator for all clauses
+    PROPAGATION_PROPAGATORS ///< Use a propagator per clause
+  };
   /// The actual problem
   Sat(const SatOptions& opt)
     : Script(opt) {
-    parseDIMACS(opt.filename.c_str());
+    parseDIMACS(opt.filename.c_str(),
+                opt.propagation() == PROPAGATION_STORE, opt.ipl());
     branch(*this, x, INT_VAR_NONE(), INT_VAL_MIN());
   }
 
@@ -141,8 +150,8 @@ public:
     os << "solution:\n" << x << std::endl;
   }
 
-  /// Post constraints according to DIMACS file \a f
-  void parseDIMACS(const char* f) {
+  /// Post constraints according to DIMACS file \a f (as store if \a s)
+  void parseDIMACS(const char* f, bool s, IntPropLevel ipl) {
     int variables = 0;
     int clauses = 0;
     std::ifstream dimacs(f);
@@ -154,6 +163,8 @@ public:
               << std::endl;
     std::string line;
     int c = 0;
+    // All literals for a single propagator
+    std::vector<int> lits;
     while (dimacs.good()) {
       std::getline(dimacs,line);
       // Comments (ignore them)
@@ -210,6 +221,15 @@ public:
           }
         }
 
+        if (s) {
+          for (unsigned int i=0; i<pos.size(); i++)
+            lits.push_back(pos[i]+1);
+          for (unsigned int i=0; i<neg.size(); i++)
+            lits.push_back(-(neg[i]+1));
+          lits.push_back(0);
+          continue;
+        }
+
         // Create positive BoolVarArgs
         BoolVarArgs positives(pos.size());
         for (int i=pos.size(); i--;)
@@ -229,6 +249,8 @@ public:
       }
     }
     dimacs.close();
+    if (s)
+      Gecode::clauses(*this, x, IntArgs(lits), ipl);
     if (clauses != c) {
       std::cerr << "error: number of specified clauses seems to be wrong."
                 << std::endl;
@@ -244,6 +266,11 @@ public:
 int main(int argc, char* argv[]) {
 
   SatOptions opt("SAT");
+  opt.propagation(Sat::PROPAGATION_STORE);
+  opt.propagation(Sat::PROPAGATION_STORE, "store",
+                  "use a single propagator for all clauses");
+  opt.propagation(Sat::PROPAGATION_PROPAGATORS, "propagators",
+                  "use a propagator for each clause");
   opt.parse(argc,argv);
 
   // Check whether all arguments are successfully parsed
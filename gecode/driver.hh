@@ -382,6 +382,7 @@ namespace Gecode {
     Driver::StringOption      _search;        ///< Search options
     Driver::UnsignedIntOption _solutions;     ///< How many solutions
     Driver::DoubleOption      _threads;       ///< How many threads to use
+    Driver::BoolOption        _deterministic; ///< Whether parallel search is deterministic
     Driver::UnsignedIntOption _c_d;           ///< Copy recomputation distance
     Driver::UnsignedIntOption _a_d;           ///< Adaptive recomputation distance
     Driver::UnsignedIntOption _d_l;           ///< Discrepancy limit for LDS
@@ -484,6 +485,11 @@ namespace Gecode {
     /// Return number of parallel threads
     double threads(void) const;
 
+    /// Set whether parallel search is deterministic
+    void deterministic(bool b);
+    /// Return whether parallel search is deterministic
+    bool deterministic(void) const;
+
     /// Set default copy recomputation distance
     void c_d(unsigned int d);
     /// Return copy recomputation distance
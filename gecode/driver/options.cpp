@@ -517,7 +517,11 @@ namespace Gecode {
       _solutions("-solutions","number of solutions (0 = all)",1),
       _threads("-threads","number of threads (0 = #processing units)",
                Search::Config::threads),
-      _c_d("-c-d","recomputation commit distance",Search::Config::c_d),
+      _deterministic("-deterministic",
+                     "whether parallel search is deterministic",
+                     Search::Config::deterministic),
+      _c_d("-c-d","recomputation commit distance (0 = adaptive)",
+           Search::Config::c_d),
       _a_d("-a-d","recomputation adaptation distance",Search::Config::a_d),
       _d_l("-d-l","discrepancy limit for LDS",Search::Config::d_l),
       _node("-node","node cutoff (0 = none, solution mode)"),
@@ -564,7 +568,7 @@ namespace Gecode {
     add(_model); add(_symmetry); add(_propagation); add(_ipl);
     add(_branching); add(_decay); add(_seed); add(_step);
     add(_search); add(_solutions); add(_threads); add(_c_d); add(_a_d);
-    add(_d_l);
+    add(_deterministic); add(_d_l);
     add(_node); add(_fail); add(_time); add(_interrupt);
     add(_assets); add(_slice);
     add(_restart); add(_r_base); add(_r_scale);
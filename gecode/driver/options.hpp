@@ -301,6 +301,15 @@ namespace Gecode {
     return _threads.value();
   }
 
+  inline void
+  Options::deterministic(bool b) {
+    _deterministic.value(b);
+  }
+  inline bool
+  Options::deterministic(void) const {
+    return _deterministic.value();
+  }
+
   inline void
   Options::c_d(unsigned int d) {
     _c_d.value(d);
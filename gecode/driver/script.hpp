@@ -327,6 +327,7 @@ namespace Gecode { namespace Driver {
           unsigned int n_b = BrancherGroup::all.size(*s);
           Search::Options so;
           so.threads = o.threads();
+          so.deterministic = o.deterministic();
           so.c_d     = o.c_d();
           so.a_d     = o.a_d();
           so.d_l     = o.d_l();
@@ -399,7 +400,11 @@ namespace Gecode { namespace Driver {
                   << "\tfailures:     " << stat.fail << endl
                   << "\trestarts:     " << stat.restart << endl
                   << "\tno-goods:     " << stat.nogood << endl
-                  << "\tpeak depth:   " << stat.depth << endl
+                  << "\tpeak depth:   " << stat.depth << endl;
+            if (o.c_d() == Search::Config::c_d_auto)
+              l_out << "\tdistances:    c-d " << stat.c_d
+                    << ", a-d " << stat.a_d << endl;
+            l_out
 #ifdef GECODE_PEAKHEAP
                   << "\tpeak memory:  "
                   << static_cast<int>((heap.peak()+1023) / 1024) << " KB"
@@ -423,6 +428,7 @@ namespace Gecode { namespace Driver {
           Search::Options so;
           so.clone   = false;
           so.threads = o.threads();
+          so.deterministic = o.deterministic();
           so.assets  = o.assets();
           so.c_d     = o.c_d();
           so.a_d     = o.a_d();
@@ -457,7 +463,11 @@ namespace Gecode { namespace Driver {
                   << "\tfailures:     " << stat.fail << endl
                   << "\trestarts:     " << stat.restart << endl
                   << "\tno-goods:     " << stat.nogood << endl
-                  << "\tpeak depth:   " << stat.depth << endl
+                  << "\tpeak depth:   " << stat.depth << endl;
+            if (o.c_d() == Search::Config::c_d_auto)
+              l_out << "\tdistances:    c-d " << stat.c_d
+                    << ", a-d " << stat.a_d << endl;
+            l_out
 #ifdef GECODE_PEAKHEAP
                   << "\tpeak memory:  "
                   << static_cast<int>((heap.peak()+1023) / 1024) << " KB"
@@ -482,6 +492,7 @@ namespace Gecode { namespace Driver {
               Search::Options so;
               so.clone   = false;
               so.threads = o.threads();
+              so.deterministic = o.deterministic();
               so.assets  = o.assets();
               so.c_d     = o.c_d();
               so.a_d     = o.a_d();
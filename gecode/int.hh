@@ -1304,6 +1304,32 @@ namespace Gecode {
   GECODE_INT_EXPORT void
   clause(Home home, BoolOpType o, const BoolVarArgs& x, const BoolVarArgs& y,
          int n, IntPropLevel ipl=IPL_DEF);
+  /** \brief Post domain consistent propagator for the clauses \a c over \a x
+   *
+   * The clauses are given in DIMACS format: the literal \f$i\f$
+   * with \f$i>0\f$ stands for \f$x_{i-1}\f$, the literal \f$-i\f$
+   * stands for \f$\neg x_{i-1}\f$, and each clause is terminated by 0
+   * (the last 0 can be omitted).
+   *
+   * All clauses are propagated by a single propagator that shares the
+   * clauses among all its copies. This is considerably more efficient
+   * than posting a propagator for each clause when the number of
+   * clauses is large.
+   *
+   * If \a ipl includes \a IPL_ADVANCED, the propagator learns a clause
+   * from each conflict (first unique implication point). Learned
+   * clauses are shared by all spaces that are copies of \a home
+   * (including spaces used by other threads) and are propagated as
+   * well. Variables assigned by other propagators or by branching
+   * count as decisions for learning.
+   *
+   * Throws an exception of type Int::OutOfLimits, if a literal
+   * refers to a variable that is not in \a x.
+   * \ingroup TaskModelIntRelBool
+   */
+  GECODE_INT_EXPORT void
+  clauses(Home home, const BoolVarArgs& x, const IntArgs& c,
+          IntPropLevel ipl=IPL_DEF);
   /** \brief Post propagator for if-then-else constraint
    *
    * Posts propagator for \f$ z = b ? x : y \f$
@@ -2102,12 +2128,20 @@ namespace Gecode {
       Tuple** last;
       /// Pointer to NULL-pointer
       Tuple* nullpointer;
+      /// Number of words in a support bitset (one bit per tuple)
+      unsigned int n_words;
+      /// Support bitsets for each position and value (NULL if no support)
+      Support::BitSetData** supports;
+      /// Support bitset data
+      Support::BitSetData* support_data;
 
       /// Add Tuple. Assumes that arity matches.
       template<class T>
       void add(T t);
       /// Finalize datastructure (disallows additions of more Tuples)
       GECODE_INT_EXPORT void finalize(void);
+      /// Initialize support bitsets (requires last structure)
+      GECODE_INT_EXPORT void init_supports(void);
       /// Resize data cache
       GECODE_INT_EXPORT void resize(void);
       /// Is datastructure finalized
@@ -2149,9 +2183,14 @@ namespace Gecode {
   /** \brief Post propagator for \f$x\in t\f$.
    *
    * \li Supports implementations optimized for speed (with propagation
-   *     level \a ipl or-ed with \a IPL_SPEED, default) and memory
+   *     level \a ipl or-ed with \a IPL_SPEED) and memory
    *     consumption (with propagation level \a ipl or-ed with
    *     \a IPL_MEMORY).
+   * \li Supports a compact table implementation based on bitsets of
+   *     valid tuples (with propagation level \a ipl or-ed with
+   *     \a IPL_ADVANCED). By default, the compact table implementation
+   *     is used for tuple sets with many tuples and the implementation
+   *     optimized for speed otherwise.
    * \li Supports domain consistency (\a ipl = IPL_DOM, default) only.
    * \li Throws an exception of type Int::ArgumentSizeMismatch, if
    *     \a x and \a t are of different size.
@@ -2173,9 +2212,14 @@ namespace Gecode {
   /** \brief Post propagator for \f$x\in t\f$.
    *
    * \li Supports implementations optimized for speed (with propagation
-   *     level \a ipl or-ed with \a IPL_SPEED, default) and memory
+   *     level \a ipl or-ed with \a IPL_SPEED) and memory
    *     consumption (with propagation level \a ipl or-ed with
    *     \a IPL_MEMORY).
+   * \li Supports a compact table implementation based on bitsets of
+   *     valid tuples (with propagation level \a ipl or-ed with
+   *     \a IPL_ADVANCED). By default, the compact table implementation
+   *     is used for tuple sets with many tuples and the implementation
+   *     optimized for speed otherwise.
    * \li Supports domain consistency (\a ipl = IPL_DOM, default) only.
    * \li Throws an exception of type Int::ArgumentSizeMismatch, if
    *     \a x and \a t are of different size.
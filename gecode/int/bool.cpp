@@ -908,6 +908,19 @@ namespace Gecode {
     }
   }
 
+  void
+  clauses(Home home, const BoolVarArgs& x, const IntArgs& c,
+          IntPropLevel ipl) {
+    using namespace Int;
+    for (int i=c.size(); i--; )
+      if ((c[i] < -x.size()) || (c[i] > x.size()))
+        throw OutOfLimits("Int::clauses");
+    GECODE_POST;
+    ViewArray<BoolView> xv(home,x);
+    GECODE_ES_FAIL(Bool::ClauseStore::post(home,xv,c,
+                                           (ipl & IPL_ADVANCED) != 0));
+  }
+
   void
   ite(Home home, BoolVar b, IntVar x, IntVar y, IntVar z,
       IntPropLevel ipl) {
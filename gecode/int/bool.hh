@@ -540,6 +540,168 @@ namespace Gecode { namespace Int { namespace Bool {
   };
 
 
+  /**
+   * \brief Propagator for a database of Boolean clauses
+   *
+   * All clauses are stored in a single array that is shared among all
+   * copies of the propagator. The first part of the array contains
+   * for each clause the position of its first literal, followed by
+   * the literals of all clauses. A literal \f$2i\f$ stands for \f$x_i\f$
+   * and a literal \f$2i+1\f$ for \f$\neg x_i\f$.
+   *
+   * Propagation uses two watched literals per clause. The watches
+   * are kept in a list per literal. Advisors record the views that
+   * become assigned.
+   *
+   * If learning is enabled, each conflict is analyzed and the
+   * resulting first unique implication point clause is added to a
+   * database of learned clauses that is shared by all copies of the
+   * propagator (also across threads). A level is the set of views
+   * assigned between two consecutive fixpoints of the propagator.
+   * Views assigned by other propagators or by branching are treated
+   * as decisions, as they come without explanation.
+   *
+   * Requires \code #include <gecode/int/bool.hh> \endcode
+   * \ingroup FuncIntProp
+   */
+  class ClauseStore : public Propagator {
+  protected:
+    /// Database of learned clauses shared by all copies
+    class Learned : public HeapAllocated {
+    public:
+      /// Mutex for access
+      Support::Mutex m;
+      /// How many propagators use the database
+      unsigned int use_cnt;
+      /// Number of clauses
+      int n;
+      /// Maximal number of literals
+      int n_max;
+      /// Position of first literal of each clause (plus end)
+      int* f;
+      /// The literals
+      int* l;
+      /// Initialize for at most \a n_max literals
+      Learned(int n_max);
+      /// Add clause with literals \a c of size \a n, return whether added
+      bool add(const int* c, int n);
+      /// Delete database
+      ~Learned(void);
+    };
+    /// The views
+    ViewArray<BoolView> x;
+    /// The clauses
+    SharedArray<int> cs;
+    /// Number of clauses
+    int n_cs;
+    /// Watches: position of watched literal and next watch in list
+    int* w;
+    /**
+     * \brief State per literal and per view
+     *
+     * The first watches for each literal, the queue of assigned views,
+     * and, if learning, for each view the clause that implied it (or
+     * -1) and its level followed by the views of the current level.
+     */
+    int* s;
+    /// Number of views in the queue
+    int n_q;
+    /// Shared database of learned clauses (NULL if no learning)
+    Learned* ld;
+    /// Number of learned clauses incorporated
+    int n_lc;
+    /// Current level
+    int lvl;
+    /// Number of views of the current level
+    int n_tr;
+    /// %Advisors for views (by index)
+    class Idx : public Advisor {
+    public:
+      /// Index of the view
+      const int i;
+      /// Create index advisor
+      Idx(Space& home, Propagator& p, Council<Idx>& c, int i);
+      /// Clone index advisor \a a
+      Idx(Space& home, bool share, Idx& a);
+    };
+    /// The advisor council
+    Council<Idx> c;
+    /// Return size of state
+    int n_s(void) const;
+    /// Return position of watched literal for watch \a w
+    int& wl(int w);
+    /// Return next watch for watch \a w
+    int& wn(int w);
+    /// Return first watch for literal \a l
+    int& wf(int l);
+    /// Return queue of assigned views
+    int* q(void);
+    /// Return clause that implied view \a i (or -1)
+    int& rs(int i);
+    /// Return level of view \a i
+    int& lv(int i);
+    /// Return views of the current level
+    int* tr(void);
+    /// Return literals of clause \a k
+    const int* lits(int k) const;
+    /// Return position of first literal of clause \a k
+    int first(int k) const;
+    /// Return position after last literal of clause \a k
+    int last(int k) const;
+    /// Test whether literal \a l is true
+    bool one(int l) const;
+    /// Test whether literal \a l is false
+    bool zero(int l) const;
+    /// Return literal for view \a i that is false
+    int zero_lit(int i) const;
+    /// Make literal \a l true as implied by clause \a k
+    ModEvent imply(Space& home, int l, int k);
+    /// Add watch \a w for position \a p of literal \a l
+    void watch(int w, int p, int l);
+    /// Incorporate new clauses from the database of learned clauses
+    ExecStatus incorporate(Space& home);
+    /// Analyze conflict for clause \a k and record learned clause
+    void analyze(Space& home, int k);
+    /// Constructor for posting
+    ClauseStore(Home home, ViewArray<BoolView>& x,
+                SharedArray<int>& cs, int n_cs, bool learn);
+    /// Constructor for cloning \a p
+    ClauseStore(Space& home, bool share, ClauseStore& p);
+  public:
+    /// Copy propagator during cloning
+    GECODE_INT_EXPORT
+    virtual Actor* copy(Space& home, bool share);
+    /// Give advice to propagator
+    GECODE_INT_EXPORT
+    virtual ExecStatus advise(Space& home, Advisor& a, const Delta& d);
+    /// Cost function (defined as low linear)
+    GECODE_INT_EXPORT
+    virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
+    /// Schedule function
+    GECODE_INT_EXPORT
+    virtual void reschedule(Space& home);
+    /// Perform propagation
+    GECODE_INT_EXPORT
+    virtual ExecStatus propagate(Space& home, const ModEventDelta& med);
+    /**
+     * \brief Post propagator for clauses \a c over \a x
+     *
+     * The clauses are given as sequence of literals, where \f$i+1\f$
+     * stands for \f$x_i\f$ and \f$-(i+1)\f$ stands for \f$\neg x_i\f$,
+     * each clause is terminated by 0. If \a learn is true, clauses are
+     * learned from conflicts.
+     */
+    GECODE_INT_EXPORT
+    static ExecStatus post(Home home, ViewArray<BoolView>& x,
+                           const IntArgs& c, bool learn);
+    /// Delete propagator and return its size
+    GECODE_INT_EXPORT
+    virtual size_t dispose(Space& home);
+    /// Maximal number of literals in learned clauses
+    static const int n_learned_max = 1 << 20;
+  };
+
+
   /**
    * \brief Boolean clause propagator (disjunctive, true)
    *
@@ -662,6 +824,7 @@ namespace Gecode { namespace Int { namespace Bool {
 #include <gecode/int/bool/or.hpp>
 #include <gecode/int/bool/eqv.hpp>
 #include <gecode/int/bool/clause.hpp>
+#include <gecode/int/bool/clause-store.hpp>
 #include <gecode/int/bool/ite.hpp>
 
 #endif
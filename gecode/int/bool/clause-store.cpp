@@ -0,0 +1,309 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main author:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/int/bool.hh>
+
+namespace Gecode { namespace Int { namespace Bool {
+
+  bool
+  ClauseStore::Learned::add(const int* c, int k) {
+    m.acquire();
+    if (f[n] + k > n_max) {
+      m.release();
+      return false;
+    }
+    for (int i=k; i--; )
+      l[f[n]+i] = c[i];
+    f[n+1] = f[n]+k;
+    // Publish the clause only after it has been written
+    Support::atomic_store(n,n+1);
+    m.release();
+    return true;
+  }
+
+  Actor*
+  ClauseStore::copy(Space& home, bool share) {
+    return new (home) ClauseStore(home,share,*this);
+  }
+
+  PropCost
+  ClauseStore::cost(const Space&, const ModEventDelta&) const {
+    return PropCost::linear(PropCost::LO,n_q);
+  }
+
+  void
+  ClauseStore::reschedule(Space& home) {
+    if (n_q > 0)
+      BoolView::schedule(home,*this,ME_BOOL_VAL);
+  }
+
+  ExecStatus
+  ClauseStore::advise(Space& home, Advisor& _a, const Delta&) {
+    Idx& a = static_cast<Idx&>(_a);
+    // Advisors are only run when their view becomes assigned
+    q()[n_q++] = a.i;
+    if (ld != NULL) {
+      lv(a.i) = lvl; tr()[n_tr++] = a.i;
+    }
+    return home.ES_NOFIX_DISPOSE(c,a);
+  }
+
+  ExecStatus
+  ClauseStore::incorporate(Space& home) {
+#ifdef GECODE_HAS_ATOMICS
+    if (Support::atomic_load(ld->n) == n_lc)
+      return ES_OK;
+#endif
+    ld->m.acquire();
+    int n = ld->n;
+    ld->m.release();
+    if (n == n_lc)
+      return ES_OK;
+    // The learned clauses are a prefix of the clauses in the database
+    const int* lf = ld->f;
+    const int* ll = ld->l;
+    w = home.realloc<int>(w,4*(n_cs+n_lc),4*(n_cs+n));
+    int o = n_lc;
+    n_lc = n;
+    for (int k=o; k<n; k++) {
+      int w0 = 2*(n_cs+k);
+      // Find two literals that are not false
+      int p0 = -1, p1 = -1;
+      for (int i=lf[k]; i<lf[k+1]; i++)
+        if (!zero(ll[i])) {
+          if (p0 < 0) {
+            p0 = i;
+          } else {
+            p1 = i; break;
+          }
+        }
+      if (p0 < 0)
+        return ES_FAILED;
+      if (p1 < 0) {
+        // The clause remains satisfied, no watches needed
+        if (!one(ll[p0]))
+          GECODE_ME_CHECK(imply(home,ll[p0],n_cs+k));
+        wl(w0) = wl(w0+1) = p0;
+        wn(w0) = wn(w0+1) = -1;
+      } else {
+        watch(w0,p0,ll[p0]); watch(w0+1,p1,ll[p1]);
+      }
+    }
+    return ES_OK;
+  }
+
+  void
+  ClauseStore::analyze(Space& home, int k) {
+    Region r(home);
+    int n = x.size();
+    // Which views have been considered
+    bool* seen = r.alloc<bool>(n);
+    for (int i=n; i--; )
+      seen[i] = false;
+    // The learned clause
+    int* lc = r.alloc<int>(n);
+    int n_l = 0;
+    // Number of views of the current level still to be resolved
+    int open = 0;
+    // Position in the views of the current level
+    int t = n_tr;
+    // View that has been resolved
+    int v = -1;
+    while (true) {
+      const int* a = lits(k);
+      for (int i=first(k); i<last(k); i++) {
+        int u = a[i] >> 1;
+        if ((u != v) && !seen[u]) {
+          seen[u] = true;
+          if (lv(u) == lvl)
+            open++;
+          else if (lv(u) > 0)
+            lc[n_l++] = a[i];
+        }
+      }
+      // The conflict does not involve the current level
+      if (open == 0)
+        return;
+      do {
+        v = tr()[--t];
+      } while (!seen[v]);
+      // Views without explanation cannot be resolved
+      while ((--open > 0) && (rs(v) < 0)) {
+        lc[n_l++] = zero_lit(v);
+        do {
+          v = tr()[--t];
+        } while (!seen[v]);
+      }
+      if (open == 0)
+        break;
+      k = rs(v);
+    }
+    // The first unique implication point
+    lc[n_l++] = zero_lit(v);
+    (void) ld->add(lc,n_l);
+  }
+
+  ExecStatus
+  ClauseStore::propagate(Space& home, const ModEventDelta&) {
+    if (ld != NULL)
+      GECODE_ES_CHECK(incorporate(home));
+    while (n_q > 0) {
+      int i = q()[--n_q];
+      // The literal that has become false
+      int* p = &wf(zero_lit(i));
+      while (*p >= 0) {
+        int w0 = *p;
+        int k = w0 >> 1;
+        const int* a = lits(k);
+        // The other watched literal
+        int o = a[wl(w0^1)];
+        if (one(o)) {
+          p = &wn(w0); continue;
+        }
+        // Try to find a new literal to watch
+        int j = first(k);
+        int e = last(k);
+        while ((j < e) &&
+               ((j == wl(w0)) || (j == wl(w0^1)) || zero(a[j])))
+          j++;
+        if (j < e) {
+          // Move watch to the literal at position j
+          *p = wn(w0);
+          watch(w0,j,a[j]);
+          continue;
+        }
+        // The clause is unit or false
+        if (zero(o)) {
+          if (ld != NULL)
+            analyze(home,k);
+          return ES_FAILED;
+        }
+        GECODE_ME_CHECK(imply(home,o,k));
+        p = &wn(w0);
+      }
+    }
+    if (ld != NULL) {
+      lvl++; n_tr = 0;
+    }
+    // All views assigned and no clause is false
+    return c.empty() ? home.ES_SUBSUMED(*this) : ES_FIX;
+  }
+
+  size_t
+  ClauseStore::dispose(Space& home) {
+    home.ignore(*this,AP_DISPOSE);
+    for (Advisors<Idx> as(c); as(); ++as)
+      x[as.advisor().i].cancel(home,as.advisor());
+    c.dispose(home);
+    home.free<int>(w,4*(n_cs+n_lc));
+    home.free<int>(s,n_s());
+    if (ld != NULL) {
+      ld->m.acquire();
+      bool d = (--ld->use_cnt == 0);
+      ld->m.release();
+      if (d)
+        delete ld;
+    }
+    cs.~SharedArray<int>();
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+  }
+
+  ExecStatus
+  ClauseStore::post(Home home, ViewArray<BoolView>& x, const IntArgs& c,
+                    bool learn) {
+    int n = x.size();
+    Region r(home);
+    // Literals and positions of first literals of the clauses kept
+    int* ls = r.alloc<int>(c.size());
+    int* fs = r.alloc<int>(c.size()+1);
+    int n_ls = 0, n_fs = 0;
+    // Last position of a literal for a view
+    int* lp = r.alloc<int>(n);
+    for (int i=n; i--; )
+      lp[i] = -1;
+    int j = 0;
+    while (j < c.size()) {
+      int f = n_ls;
+      bool sat = false;
+      for ( ; (j < c.size()) && (c[j] != 0); j++) {
+        int i = std::abs(c[j]) - 1;
+        int lit = 2*i + ((c[j] < 0) ? 1 : 0);
+        if (sat || ((c[j] > 0) ? x[i].zero() : x[i].one()))
+          continue;
+        if (((c[j] > 0) ? x[i].one() : x[i].zero())) {
+          sat = true; continue;
+        }
+        if ((lp[i] >= f) && (lp[i] < n_ls) && ((ls[lp[i]] >> 1) == i)) {
+          // Either a duplicate literal or a tautology
+          if (ls[lp[i]] != lit)
+            sat = true;
+          continue;
+        }
+        lp[i] = n_ls; ls[n_ls++] = lit;
+      }
+      j++;
+      if (sat) {
+        n_ls = f;
+      } else if (n_ls == f) {
+        return ES_FAILED;
+      } else if (n_ls == f+1) {
+        n_ls = f;
+        if (ls[f] & 1) {
+          GECODE_ME_CHECK(x[ls[f] >> 1].zero(home));
+        } else {
+          GECODE_ME_CHECK(x[ls[f] >> 1].one(home));
+        }
+      } else {
+        fs[n_fs++] = f;
+      }
+    }
+    if (n_fs == 0)
+      return ES_OK;
+    SharedArray<int> cs(n_fs+1+n_ls);
+    for (int i=n_fs; i--; )
+      cs[i] = n_fs+1+fs[i];
+    cs[n_fs] = n_fs+1+n_ls;
+    for (int i=n_ls; i--; )
+      cs[n_fs+1+i] = ls[i];
+    (void) new (home) ClauseStore(home,x,cs,n_fs,learn);
+    return ES_OK;
+  }
+
+}}}
+
+// STATISTICS: int-prop
@@ -0,0 +1,204 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main author:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode { namespace Int { namespace Bool {
+
+  /*
+   * Index advisors
+   *
+   */
+  forceinline
+  ClauseStore::Idx::Idx(Space& home, Propagator& p,
+                        Council<Idx>& c, int i0)
+    : Advisor(home,p,c), i(i0) {}
+
+  forceinline
+  ClauseStore::Idx::Idx(Space& home, bool share, Idx& a)
+    : Advisor(home,share,a), i(a.i) {}
+
+
+  /*
+   * Database of learned clauses
+   *
+   */
+  /*
+   * The arrays are allocated for the maximal number of literals and
+   * are never moved: published clauses can then be read without
+   * holding the mutex.
+   */
+  forceinline
+  ClauseStore::Learned::Learned(int n_max0)
+    : use_cnt(1), n(0), n_max(n_max0),
+      f(heap.alloc<int>(n_max0+1)), l(heap.alloc<int>(n_max0)) {
+    f[0] = 0;
+  }
+
+  forceinline
+  ClauseStore::Learned::~Learned(void) {
+    heap.rfree(f); heap.rfree(l);
+  }
+
+
+  /*
+   * Access to state
+   *
+   */
+  forceinline int
+  ClauseStore::n_s(void) const {
+    return ((ld != NULL) ? 6 : 3)*x.size();
+  }
+  forceinline int&
+  ClauseStore::wl(int w0) {
+    return w[2*w0];
+  }
+  forceinline int&
+  ClauseStore::wn(int w0) {
+    return w[2*w0+1];
+  }
+  forceinline int&
+  ClauseStore::wf(int l) {
+    return s[l];
+  }
+  forceinline int*
+  ClauseStore::q(void) {
+    return s + 2*x.size();
+  }
+  forceinline int&
+  ClauseStore::rs(int i) {
+    return s[3*x.size() + i];
+  }
+  forceinline int&
+  ClauseStore::lv(int i) {
+    return s[4*x.size() + i];
+  }
+  forceinline int*
+  ClauseStore::tr(void) {
+    return s + 5*x.size();
+  }
+
+  forceinline const int*
+  ClauseStore::lits(int k) const {
+    return (k < n_cs) ? cs.begin() : ld->l;
+  }
+  forceinline int
+  ClauseStore::first(int k) const {
+    return (k < n_cs) ? cs[k] : ld->f[k-n_cs];
+  }
+  forceinline int
+  ClauseStore::last(int k) const {
+    return (k < n_cs) ? cs[k+1] : ld->f[k-n_cs+1];
+  }
+
+  forceinline bool
+  ClauseStore::one(int l) const {
+    return (l & 1) ? x[l >> 1].zero() : x[l >> 1].one();
+  }
+  forceinline bool
+  ClauseStore::zero(int l) const {
+    return (l & 1) ? x[l >> 1].one() : x[l >> 1].zero();
+  }
+  forceinline int
+  ClauseStore::zero_lit(int i) const {
+    return x[i].one() ? 2*i+1 : 2*i;
+  }
+
+  forceinline ModEvent
+  ClauseStore::imply(Space& home, int l, int k) {
+    if (ld != NULL)
+      rs(l >> 1) = k;
+    return (l & 1) ? x[l >> 1].zero_none(home) : x[l >> 1].one_none(home);
+  }
+
+  forceinline void
+  ClauseStore::watch(int w0, int p, int l) {
+    wl(w0) = p; wn(w0) = wf(l); wf(l) = w0;
+  }
+
+
+  /*
+   * The propagator proper
+   *
+   */
+  forceinline
+  ClauseStore::ClauseStore(Home home, ViewArray<BoolView>& x0,
+                           SharedArray<int>& cs0, int n_cs0, bool learn)
+    : Propagator(home), x(x0), cs(cs0), n_cs(n_cs0), n_q(0),
+      ld(learn ? new Learned(n_learned_max) : NULL),
+      n_lc(0), lvl(1), n_tr(0), c(home) {
+    home.notice(*this,AP_DISPOSE);
+    w = static_cast<Space&>(home).alloc<int>(4*n_cs);
+    s = static_cast<Space&>(home).alloc<int>(n_s());
+    for (int l=2*x.size(); l--; )
+      wf(l) = -1;
+    // Watch the first two literals of each clause
+    for (int i=n_cs; i--; )
+      for (int w0=2*i; w0<2*i+2; w0++)
+        watch(w0,cs[i] + (w0 & 1),cs[cs[i] + (w0 & 1)]);
+    if (ld != NULL)
+      for (int i=x.size(); i--; ) {
+        rs(i) = -1; lv(i) = 0;
+      }
+    for (int i=x.size(); i--; )
+      if (x[i].assigned())
+        q()[n_q++] = i;
+      else
+        x[i].subscribe(home,*new (home) Idx(home,*this,c,i));
+    if (n_q > 0)
+      BoolView::schedule(home,*this,ME_BOOL_VAL);
+  }
+
+  forceinline
+  ClauseStore::ClauseStore(Space& home, bool share, ClauseStore& p)
+    : Propagator(home,share,p), n_cs(p.n_cs), n_q(p.n_q),
+      ld(p.ld), n_lc(p.n_lc), lvl(p.lvl), n_tr(p.n_tr) {
+    x.update(home,share,p.x);
+    cs.update(home,share,p.cs);
+    c.update(home,share,p.c);
+    w = home.alloc<int>(4*(n_cs+n_lc));
+    Heap::copy<int>(w,p.w,4*(n_cs+n_lc));
+    s = home.alloc<int>(n_s());
+    Heap::copy<int>(s,p.s,n_s());
+    if (ld != NULL) {
+      ld->m.acquire();
+      ld->use_cnt++;
+      ld->m.release();
+    }
+  }
+
+}}}
+
+// STATISTICS: int-prop
@@ -88,6 +88,12 @@ namespace Gecode {
         GECODE_ES_FAIL((Extensional::Basic<IntView,false>
                              ::post(home,xv,t)));
       }
+    } else if (!x.same(home) &&
+               ((ipl & IPL_ADVANCED) ||
+                (!(ipl & IPL_SPEED) &&
+                 (t.tuples() >= Extensional::compact_threshold)))) {
+      GECODE_ES_FAIL((Extensional::Compact<IntView>
+                           ::post(home,xv,t)));
     } else {
       GECODE_ES_FAIL((Extensional::Incremental<IntView>
                            ::post(home,xv,t)));
@@ -121,6 +127,12 @@ namespace Gecode {
         GECODE_ES_FAIL((Extensional::Basic<BoolView,false>
                              ::post(home,xv,t)));
       }
+    } else if (!x.same(home) &&
+               ((ipl & IPL_ADVANCED) ||
+                (!(ipl & IPL_SPEED) &&
+                 (t.tuples() >= Extensional::compact_threshold)))) {
+      GECODE_ES_FAIL((Extensional::Compact<BoolView>
+                           ::post(home,xv,t)));
     } else {
       GECODE_ES_FAIL((Extensional::Incremental<BoolView>
                            ::post(home,xv,t)));
@@ -506,6 +506,141 @@ namespace Gecode { namespace Int { namespace Extensional {
 #include <gecode/int/extensional/incremental.hpp>
 
 
+namespace Gecode { namespace Int { namespace Extensional {
+
+  /**
+   * \brief Sparse bitset of tuples
+   *
+   * Only the non-zero words of the bitset are stored: the first
+   * \a limit + 1 words are the non-zero words and \a index maps them
+   * to their position in the full bitset. A word becoming zero is
+   * swapped behind the limit, hence copying the bitset only copies
+   * the non-zero words.
+   *
+   * Masks passed to the operations are indexed by the position of the
+   * stored word, support bitsets by the position in the full bitset.
+   *
+   * Requires \code #include <gecode/int/extensional.hh> \endcode
+   * \ingroup FuncIntProp
+   */
+  class SparseBitSet {
+  protected:
+    /// Stored words
+    Support::BitSetData* words;
+    /// Position of stored word in full bitset
+    unsigned int* index;
+    /// Position of last non-zero word (-1 if all words are zero)
+    int limit;
+    /// Number of allocated words
+    unsigned int n;
+    /// Replace word at position \a k by \a w (and remove if zero)
+    void replace(int k, Support::BitSetData w);
+  public:
+    /// Initialize as empty
+    SparseBitSet(void);
+    /// Initialize with the first \a n_bits bits set
+    void init(Space& home, unsigned int n_bits);
+    /// Initialize as copy of \a s
+    void update(Space& home, const SparseBitSet& s);
+    /// Test whether no bit is set
+    bool empty(void) const;
+    /// Return number of words needed for a mask
+    unsigned int words_mask(void) const;
+    /// Clear the mask \a m
+    void clear_mask(Support::BitSetData* m) const;
+    /// Add support bitset \a b to mask \a m
+    void add_to_mask(const Support::BitSetData* b,
+                     Support::BitSetData* m) const;
+    /// Intersect with mask \a m
+    void intersect_with_mask(const Support::BitSetData* m);
+    /// Intersect with complement of mask \a m
+    void nand_with_mask(const Support::BitSetData* m);
+    /// Test whether support bitset \a b intersects
+    bool intersects(const Support::BitSetData* b) const;
+    /// Release memory
+    void dispose(Space& home);
+  };
+
+  /**
+   * \brief Domain consistent extensional propagator based on compact tables
+   *
+   * The propagator maintains the tuples that are still valid with
+   * respect to the current domains as a sparse bitset and uses
+   * word-wise intersection with the support bitsets of the tuple set
+   * for both updating and filtering. The algorithm is based on:
+   *   Jordan Demeulenaere, Renaud Hartert, Christophe Lecoutre,
+   *   Guillaume Perez, Laurent Perron, Jean-Charles Rgin,
+   *   Pierre Schaus, Compact-Table: Efficiently Filtering Table
+   *   Constraints with Reversible Sparse Bit-Sets, CP 2016.
+   *   Pages 207-223, LNCS 9892, Springer-Verlag, 2016.
+   *
+   * The propagator is not capable of dealing with multiple occurences
+   * of the same view.
+   *
+   * Requires \code #include <gecode/int/extensional.hh> \endcode
+   * \ingroup FuncIntProp
+   */
+  template<class View>
+  class Compact : public Propagator {
+  protected:
+    /// %Advisors for views (by position in array)
+    class CTAdvisor : public Advisor {
+    public:
+      /// The position of the view in the view array
+      int i;
+      /// Create advisor for view at position \a i
+      CTAdvisor(Space& home, Propagator& p, Council<CTAdvisor>& c, int i);
+      /// Clone advisor \a a
+      CTAdvisor(Space& home, bool share, CTAdvisor& a);
+    };
+    /// The views
+    ViewArray<View> x;
+    /// Definition of constraint
+    TupleSet tupleSet;
+    /// The advisor council
+    Council<CTAdvisor> c;
+    /// The currently valid tuples
+    SparseBitSet table;
+    /// Whether the propagator is currently pruning
+    bool pruning;
+    /// Access real tuple-set
+    TupleSet::TupleSetI* ts(void);
+    /// Return support bitset for view at position \a i and value \a n
+    const Support::BitSetData* supports(int i, int n);
+    /// Keep only tuples supported by the values of view at position \a i
+    void reset(Space& home, int i);
+    /// Constructor for cloning \a p
+    Compact(Space& home, bool share, Compact<View>& p);
+    /// Constructor for posting
+    Compact(Home home, ViewArray<View>& x, const TupleSet& t);
+  public:
+    /// Cost function (defined as high linear)
+    virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
+    /// Schedule function
+    virtual void reschedule(Space& home);
+    /// Give advice to propagator
+    virtual ExecStatus advise(Space& home, Advisor& a, const Delta& d);
+    /// Perform propagation
+    virtual ExecStatus propagate(Space& home, const ModEventDelta& med);
+    /// Copy propagator during cloning
+    virtual Actor* copy(Space& home, bool share);
+    /// Delete propagator and return its size
+    virtual size_t dispose(Space& home);
+    /// Post propagator for views \a x
+    static ExecStatus post(Home home, ViewArray<View>& x, const TupleSet& t);
+  };
+
+  /**
+   * \brief Minimal number of tuples for which the compact table
+   * propagator is used by default
+   */
+  const int compact_threshold = 256;
+
+}}}
+
+#include <gecode/int/extensional/compact.hpp>
+
+
 #endif
 
 // STATISTICS: int-prop
@@ -0,0 +1,329 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode { namespace Int { namespace Extensional {
+
+  /*
+   * Sparse bitset
+   *
+   */
+  forceinline
+  SparseBitSet::SparseBitSet(void)
+    : words(NULL), index(NULL), limit(-1), n(0U) {}
+
+  forceinline void
+  SparseBitSet::init(Space& home, unsigned int n_bits) {
+    n = Support::BitSetData::data(n_bits);
+    words = home.alloc<Support::BitSetData>(n);
+    index = home.alloc<unsigned int>(n);
+    for (unsigned int k = n; k--; ) {
+      words[k].init(true);
+      index[k] = k;
+    }
+    // Clear the bits beyond the last tuple
+    unsigned int bpb = Support::BitSetData::bpb;
+    if (n_bits % bpb != 0U)
+      for (unsigned int b = n_bits % bpb; b < bpb; b++)
+        words[n-1].clear(b);
+    limit = static_cast<int>(n)-1;
+  }
+
+  forceinline void
+  SparseBitSet::update(Space& home, const SparseBitSet& s) {
+    n = static_cast<unsigned int>(s.limit+1);
+    words = home.alloc<Support::BitSetData>(n);
+    index = home.alloc<unsigned int>(n);
+    for (unsigned int k = n; k--; ) {
+      words[k] = s.words[k];
+      index[k] = s.index[k];
+    }
+    limit = s.limit;
+  }
+
+  forceinline void
+  SparseBitSet::replace(int k, Support::BitSetData w) {
+    assert(k <= limit);
+    if (w.none()) {
+      words[k] = words[limit];
+      std::swap(index[k],index[limit]);
+      limit--;
+    } else {
+      words[k] = w;
+    }
+  }
+
+  forceinline bool
+  SparseBitSet::empty(void) const {
+    return limit < 0;
+  }
+
+  forceinline unsigned int
+  SparseBitSet::words_mask(void) const {
+    return static_cast<unsigned int>(limit+1);
+  }
+
+  forceinline void
+  SparseBitSet::clear_mask(Support::BitSetData* m) const {
+    for (int k = limit+1; k--; )
+      m[k].init(false);
+  }
+
+  forceinline void
+  SparseBitSet::add_to_mask(const Support::BitSetData* b,
+                            Support::BitSetData* m) const {
+    for (int k = limit+1; k--; )
+      m[k].o(b[index[k]]);
+  }
+
+  forceinline void
+  SparseBitSet::intersect_with_mask(const Support::BitSetData* m) {
+    // Iterate downwards as words might be moved behind the limit
+    for (int k = limit+1; k--; ) {
+      Support::BitSetData w = Support::BitSetData::a(words[k],m[k]);
+      if (!w.same(words[k]))
+        replace(k,w);
+    }
+  }
+
+  forceinline void
+  SparseBitSet::nand_with_mask(const Support::BitSetData* m) {
+    for (int k = limit+1; k--; ) {
+      Support::BitSetData w =
+        Support::BitSetData::a(words[k],Support::BitSetData::neg(m[k]));
+      if (!w.same(words[k]))
+        replace(k,w);
+    }
+  }
+
+  forceinline bool
+  SparseBitSet::intersects(const Support::BitSetData* b) const {
+    for (int k = 0; k <= limit; k++)
+      if (!Support::BitSetData::a(words[k],b[index[k]]).none())
+        return true;
+    return false;
+  }
+
+  forceinline void
+  SparseBitSet::dispose(Space& home) {
+    home.free<Support::BitSetData>(words,n);
+    home.free<unsigned int>(index,n);
+  }
+
+
+  /*
+   * Advisor
+   *
+   */
+  template<class View>
+  forceinline
+  Compact<View>::CTAdvisor::CTAdvisor(Space& home, Propagator& p,
+                                      Council<CTAdvisor>& c, int i0)
+    : Advisor(home,p,c), i(i0) {}
+
+  template<class View>
+  forceinline
+  Compact<View>::CTAdvisor::CTAdvisor(Space& home, bool share,
+                                      CTAdvisor& a)
+    : Advisor(home,share,a), i(a.i) {}
+
+
+  /*
+   * The propagator proper
+   *
+   */
+  template<class View>
+  forceinline TupleSet::TupleSetI*
+  Compact<View>::ts(void) {
+    return tupleSet.implementation();
+  }
+
+  template<class View>
+  forceinline const Support::BitSetData*
+  Compact<View>::supports(int i, int n) {
+    if ((n < ts()->min) || (n > ts()->max))
+      return NULL;
+    return ts()->supports[(i*ts()->domsize) + (n - ts()->min)];
+  }
+
+  template<class View>
+  forceinline void
+  Compact<View>::reset(Space& home, int i) {
+    Region r(home);
+    Support::BitSetData* m =
+      r.alloc<Support::BitSetData>(table.words_mask());
+    table.clear_mask(m);
+    for (ViewValues<View> vv(x[i]); vv(); ++vv)
+      if (const Support::BitSetData* s = supports(i,vv.val()))
+        table.add_to_mask(s,m);
+    table.intersect_with_mask(m);
+  }
+
+  template<class View>
+  forceinline
+  Compact<View>::Compact(Home home, ViewArray<View>& x0, const TupleSet& t)
+    : Propagator(home), x(x0), tupleSet(t), c(home), pruning(false) {
+    assert(ts()->finalized());
+    home.notice(*this,AP_DISPOSE);
+    table.init(home,static_cast<unsigned int>(t.tuples()));
+    for (int i = x.size(); i--; ) {
+      if (!x[i].assigned())
+        x[i].subscribe(home,*new (home) CTAdvisor(home,*this,c,i));
+      reset(home,i);
+    }
+    // Failure is detected and values are pruned by propagation
+    View::schedule(home,*this,ME_INT_VAL);
+  }
+
+  template<class View>
+  forceinline ExecStatus
+  Compact<View>::post(Home home, ViewArray<View>& x, const TupleSet& t) {
+    // All variables in the correct domain
+    for (int i = x.size(); i--; ) {
+      GECODE_ME_CHECK(x[i].gq(home, t.min()));
+      GECODE_ME_CHECK(x[i].lq(home, t.max()));
+    }
+    (void) new (home) Compact<View>(home,x,t);
+    return ES_OK;
+  }
+
+  template<class View>
+  forceinline
+  Compact<View>::Compact(Space& home, bool share, Compact<View>& p)
+    : Propagator(home,share,p), pruning(false) {
+    x.update(home,share,p.x);
+    tupleSet.update(home,share,p.tupleSet);
+    c.update(home,share,p.c);
+    table.update(home,p.table);
+  }
+
+  template<class View>
+  Actor*
+  Compact<View>::copy(Space& home, bool share) {
+    return new (home) Compact<View>(home,share,*this);
+  }
+
+  template<class View>
+  PropCost
+  Compact<View>::cost(const Space&, const ModEventDelta&) const {
+    return PropCost::linear(PropCost::HI,x.size());
+  }
+
+  template<class View>
+  void
+  Compact<View>::reschedule(Space& home) {
+    View::schedule(home,*this,ME_INT_VAL);
+  }
+
+  template<class View>
+  ExecStatus
+  Compact<View>::advise(Space& home, Advisor& _a, const Delta& d) {
+    // Values pruned by the propagator itself do not support any tuple
+    if (pruning)
+      return ES_FIX;
+    CTAdvisor& a = static_cast<CTAdvisor&>(_a);
+    View xa = x[a.i];
+    if (!xa.any(d)) {
+      int l = std::max(xa.min(d),ts()->min);
+      int u = std::min(xa.max(d),ts()->max);
+      // Only use the removed values when there are few of them
+      if (static_cast<unsigned int>(std::max(u-l+1,0)) <= xa.size()) {
+        Region r(home);
+        Support::BitSetData* m =
+          r.alloc<Support::BitSetData>(table.words_mask());
+        table.clear_mask(m);
+        for (int n = l; n <= u; n++)
+          if (const Support::BitSetData* s = supports(a.i,n))
+            table.add_to_mask(s,m);
+        table.nand_with_mask(m);
+        return table.empty() ? ES_FAILED : ES_NOFIX;
+      }
+    }
+    reset(home,a.i);
+    return table.empty() ? ES_FAILED : ES_NOFIX;
+  }
+
+  template<class View>
+  ExecStatus
+  Compact<View>::propagate(Space& home, const ModEventDelta&) {
+    if (table.empty())
+      return ES_FAILED;
+    Region r(home);
+    pruning = true;
+    bool assigned = true;
+    for (int i = x.size(); i--; ) {
+      // All valid tuples agree with the value of an assigned view
+      if (x[i].assigned())
+        continue;
+      unsigned int n = x[i].size();
+      int* nq = r.alloc<int>(n);
+      int n_nq = 0;
+      for (ViewValues<View> vv(x[i]); vv(); ++vv) {
+        const Support::BitSetData* s = supports(i,vv.val());
+        if ((s == NULL) || !table.intersects(s))
+          nq[n_nq++] = vv.val();
+      }
+      if (n_nq > 0) {
+        Iter::Values::Array v(nq,n_nq);
+        ModEvent me = x[i].minus_v(home,v,false);
+        if (me_failed(me)) {
+          pruning = false;
+          return ES_FAILED;
+        }
+      }
+      r.free<int>(nq,n);
+      if (!x[i].assigned())
+        assigned = false;
+    }
+    pruning = false;
+    return assigned ? home.ES_SUBSUMED(*this) : ES_FIX;
+  }
+
+  template<class View>
+  forceinline size_t
+  Compact<View>::dispose(Space& home) {
+    home.ignore(*this,AP_DISPOSE);
+    c.dispose(home);
+    table.dispose(home);
+    (void) tupleSet.~TupleSet();
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+  }
+
+}}}
+
+// STATISTICS: int-prop
+
@@ -158,9 +158,46 @@ namespace Gecode {
       }
     }
 
+    init_supports();
+
     assert(finalized());
   }
 
+  void
+  TupleSet::TupleSetI::init_supports(void) {
+    // The final largest tuple is not a real tuple
+    unsigned int n_tuples = static_cast<unsigned int>(size-1);
+    n_words = Support::BitSetData::data(n_tuples);
+
+    // Only values that occur at a position need a support bitset
+    unsigned int literals = domsize*static_cast<unsigned int>(arity);
+    unsigned int n_supported = 0;
+    for (unsigned int l = literals; l--; )
+      if (last[l] != nullpointer)
+        n_supported++;
+
+    supports = heap.alloc<Support::BitSetData*>(literals);
+    support_data = heap.alloc<Support::BitSetData>(n_supported*n_words);
+    for (unsigned int w = n_supported*n_words; w--; )
+      support_data[w].init(false);
+
+    Support::BitSetData* s = support_data;
+    for (unsigned int l = 0; l < literals; l++)
+      if (last[l] != nullpointer) {
+        supports[l] = s; s += n_words;
+      } else {
+        supports[l] = NULL;
+      }
+
+    // Tuples are numbered by their position in the sorted tuple data
+    for (unsigned int t = 0; t < n_tuples; t++)
+      for (int i = arity; i--; ) {
+        unsigned int v = static_cast<unsigned int>(data[t*arity+i]-min);
+        Support::BitSetData* b = supports[i*domsize+v];
+        b[t / Support::BitSetData::bpb].set(t % Support::BitSetData::bpb);
+      }
+  }
+
   void
   TupleSet::TupleSetI::resize(void) {
     assert(excess == 0);
@@ -205,6 +242,20 @@ namespace Gecode {
       d->last[i] = d->tuple_data + (last[i]-tuple_data);
     }
 
+    // Support data
+    unsigned int literals = domsize*static_cast<unsigned int>(arity);
+    unsigned int n_supported = 0;
+    for (unsigned int l = literals; l--; )
+      if (supports[l] != NULL)
+        n_supported++;
+    d->n_words = n_words;
+    d->supports = heap.alloc<Support::BitSetData*>(literals);
+    d->support_data = heap.alloc<Support::BitSetData>(n_supported*n_words);
+    heap.copy(&d->support_data[0], &support_data[0], n_supported*n_words);
+    for (unsigned int l = literals; l--; )
+      d->supports[l] = (supports[l] == NULL) ? NULL :
+        d->support_data + (supports[l]-support_data);
+
     return d;
   }
 
@@ -214,6 +265,8 @@ namespace Gecode {
     heap.rfree(tuple_data);
     heap.rfree(data);
     heap.rfree(last);
+    heap.rfree(supports);
+    heap.rfree(support_data);
   }
 
 }
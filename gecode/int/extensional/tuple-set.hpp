@@ -58,7 +58,10 @@ namespace Gecode {
       max(Int::Limits::min),
       domsize(0),
       last(NULL),
-      nullpointer(NULL)
+      nullpointer(NULL),
+      n_words(0U),
+      supports(NULL),
+      support_data(NULL)
   {}
 
 
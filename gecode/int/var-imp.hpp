@@ -201,6 +201,64 @@ namespace Gecode { namespace Int {
     /// Size of holes in the domain
     unsigned int holes;
 
+    /**
+     * \brief Bitsets for small domains with holes
+     *
+     * The domain consists of all values between the minimum and the
+     * maximum of the domain whose bit is set, bits for values outside
+     * the bounds are meaningless. A domain is represented by a bitset
+     * (rather than by a range list) if its width does not exceed
+     * \a bits_max when it gets holes. Then the last element of the
+     * range list is a marked pointer to the bitset.
+     */
+    class BitDom {
+    protected:
+      /// Return number of set bits from bit \a l to bit \a h in \a w
+      static unsigned int count(Support::BitSetData w,
+                                unsigned int l, unsigned int h);
+    public:
+      /// Value corresponding to the first bit
+      int o;
+      /// The bits (more bits follow)
+      Support::BitSetData b[1];
+      /// Allocate bitset for values from \a o with \a n words (all bits clear)
+      static BitDom* allocate(Space& home, int o, unsigned int n);
+      /// Test whether \a v is included
+      bool get(int v) const;
+      /// Exclude \a v
+      void clear(int v);
+      /// Include all values from \a l to \a h
+      void set(int l, int h);
+      /// Return smallest included value greater or equal to \a v (must exist)
+      int next_in(int v) const;
+      /// Return largest included value less or equal to \a v (must exist)
+      int prev_in(int v) const;
+      /// Return smallest excluded value greater or equal to \a v, \a u+1 if there is none up to \a u
+      int next_out(int v, int u) const;
+      /// Return largest excluded value less or equal to \a v, \a l-1 if there is none down to \a l
+      int prev_out(int v, int l) const;
+      /// Return number of included values from \a l to \a h
+      unsigned int count(int l, int h) const;
+    };
+    /// Largest width of a domain with holes that is represented by a bitset
+    static const unsigned int bits_max = 512U;
+    /// Test whether domain is represented by a bitset
+    bool bits(void) const;
+    /// Return bitset
+    BitDom* bitdom(void) const;
+    /// Set bitset to \a bd
+    void bitdom(BitDom* bd);
+    /// Represent the current domain by a bitset
+    GECODE_INT_EXPORT void tobits(Space& home);
+    /// Update bounds and holes after \a h values have been removed from the bitset
+    GECODE_INT_EXPORT ModEvent bits_removed(Space& home, unsigned int h);
+    /// Replace bitset domain by \a min0 to \a max0 and ranges \a ri
+    template<class I>
+    ModEvent narrow_bits(Space& home, int min0, int max0, I& ri);
+    /// Remove from bitset domain \a i_min to \a i_max and ranges \a i
+    template<class I>
+    ModEvent minus_bits(Space& home, int i_min, int i_max, I& i);
+
   protected:
     /// Constructor for cloning \a x
     IntVarImp(Space& home, bool share, IntVarImp& x);
@@ -392,6 +450,12 @@ namespace Gecode { namespace Int {
     const IntVarImp::RangeList* p;
     /// Current range
     const IntVarImp::RangeList* c;
+    /// Bitset (NULL if domain is not represented by a bitset)
+    const IntVarImp::BitDom* b;
+    /// Minimum and maximum of current range
+    int mi, ma;
+    /// Maximum of domain (for bitsets)
+    int u;
   public:
     /// \name Constructors and initialization
     //@{
@@ -435,6 +499,12 @@ namespace Gecode { namespace Int {
     const IntVarImp::RangeList* n;
     /// Current range
     const IntVarImp::RangeList* c;
+    /// Bitset (NULL if domain is not represented by a bitset)
+    const IntVarImp::BitDom* b;
+    /// Minimum and maximum of current range
+    int mi, ma;
+    /// Minimum of domain (for bitsets)
+    int l;
   public:
     /// \name Constructors and initialization
     //@{
@@ -49,11 +49,18 @@ namespace Gecode { namespace Int {
   int
   IntVarImp::med(void) const {
     // Computes the median
-    if (fst() == NULL)
+    if (range())
       return (dom.min()+dom.max())/2 - ((dom.min()+dom.max())%2 < 0 ? 1 : 0);
     unsigned int i = size() / 2;
     if (size() % 2 == 0)
       i--;
+    if (bits()) {
+      IntVarImpFwd r(this);
+      while (i >= r.width()) {
+        i -= r.width(); ++r;
+      }
+      return r.min() + static_cast<int>(i);
+    }
     const RangeList* p = NULL;
     const RangeList* c = fst();
     while (i >= c->width()) {
@@ -65,6 +72,8 @@ namespace Gecode { namespace Int {
 
   bool
   IntVarImp::in_full(int m) const {
+    if (bits())
+      return bitdom()->get(m);
     if (closer_min(m)) {
       const RangeList* p = NULL;
       const RangeList* c = fst();
@@ -95,6 +104,13 @@ namespace Gecode { namespace Int {
     if (range()) { // Is already range...
       dom.max(m);
       if (assigned()) me = ME_INT_VAL;
+    } else if (bits()) { // Is bitset...
+      int max_n = bitdom()->prev_in(m);
+      unsigned int c = (max_n < dom.max()) ?
+        bitdom()->count(max_n+1,dom.max()) : 0U;
+      holes -= static_cast<unsigned int>(dom.max()-max_n) - c;
+      dom.max(max_n);
+      if (assigned()) me = ME_INT_VAL;
     } else if (m < fst()->next(NULL)->min()) { // Becomes range...
       dom.max(std::min(m,fst()->max()));
       fst()->dispose(home,NULL,lst());
@@ -128,6 +144,13 @@ namespace Gecode { namespace Int {
     if (range()) { // Is already range...
       dom.min(m);
       if (assigned()) me = ME_INT_VAL;
+    } else if (bits()) { // Is bitset...
+      int min_n = bitdom()->next_in(m);
+      unsigned int c = (min_n > dom.min()) ?
+        bitdom()->count(dom.min(),min_n-1) : 0U;
+      holes -= static_cast<unsigned int>(min_n-dom.min()) - c;
+      dom.min(min_n);
+      if (assigned()) me = ME_INT_VAL;
     } else if (m > lst()->prev(NULL)->max()) { // Becomes range...
       dom.min(std::max(m,lst()->min()));
       fst()->dispose(home,NULL,lst());
@@ -156,7 +179,11 @@ namespace Gecode { namespace Int {
   ModEvent
   IntVarImp::eq_full(Space& home, int m) {
     dom.min(m); dom.max(m);
-    if (!range()) {
+    if (bits() && !range()) {
+      holes = 0;
+      if (!bitdom()->get(m))
+        return ME_INT_FAILED;
+    } else if (!range()) {
       bool failed = false;
       RangeList* p = NULL;
       RangeList* c = fst();
@@ -181,6 +208,9 @@ namespace Gecode { namespace Int {
   ModEvent
   IntVarImp::nq_full(Space& home, int m) {
     assert(!((m < dom.min()) || (m > dom.max())));
+    if (!bits() && (width() <= bits_max) &&
+        (!range() || ((m != dom.min()) && (m != dom.max()))))
+      tobits(home);
     ModEvent me = ME_INT_DOM;
     if (range()) {
       if ((m == dom.min()) && (m == dom.max()))
@@ -191,6 +221,8 @@ namespace Gecode { namespace Int {
       } else if (m == dom.max()) {
         dom.max(m-1);
         me = assigned() ? ME_INT_VAL : ME_INT_BND;
+      } else if (bits()) {
+        bitdom()->clear(m); holes = 1;
       } else {
         RangeList* f = new (home) RangeList(dom.min(),m-1);
         RangeList* l = new (home) RangeList(m+1,dom.max());
@@ -198,6 +230,24 @@ namespace Gecode { namespace Int {
         l->prevnext(f,NULL);
         fst(f); lst(l); holes = 1;
       }
+    } else if (bits()) { // Is bitset...
+      BitDom* bd = bitdom();
+      if (!bd->get(m))
+        return ME_INT_NONE;
+      bd->clear(m);
+      if (m == dom.min()) {
+        int min_n = bd->next_in(m+1);
+        holes -= static_cast<unsigned int>(min_n-m-1);
+        dom.min(min_n);
+        me = assigned() ? ME_INT_VAL : ME_INT_BND;
+      } else if (m == dom.max()) {
+        int max_n = bd->prev_in(m-1);
+        holes -= static_cast<unsigned int>(m-max_n-1);
+        dom.max(max_n);
+        me = assigned() ? ME_INT_VAL : ME_INT_BND;
+      } else {
+        holes += 1;
+      }
     } else if (m < fst()->next(NULL)->min()) { // Concerns the first range...
       int f_max = fst()->max();
       if (m > f_max)
@@ -310,6 +360,55 @@ namespace Gecode { namespace Int {
 
 
 
+  /*
+   * Bitset domains
+   *
+   */
+
+  void
+  IntVarImp::tobits(Space& home) {
+    assert(!bits() && (width() <= bits_max));
+    BitDom* bd = BitDom::allocate(home,dom.min(),
+                                  Support::BitSetData::data(width()));
+    if (range()) {
+      bd->set(dom.min(),dom.max());
+    } else {
+      for (IntVarImpFwd r(this); r(); ++r)
+        bd->set(r.min(),r.max());
+      fst()->dispose(home,NULL,lst());
+      fst(NULL);
+    }
+    bitdom(bd);
+  }
+
+  ModEvent
+  IntVarImp::bits_removed(Space& home, unsigned int h) {
+    assert(bits());
+    if (h == 0)
+      return ME_INT_NONE;
+    if (h == size())
+      return ME_INT_FAILED;
+    unsigned int s = size() - h;
+    const BitDom* bd = bitdom();
+    const int min1 = dom.min();
+    const int max1 = dom.max();
+    if (!bd->get(min1))
+      dom.min(bd->next_in(min1));
+    if (!bd->get(max1))
+      dom.max(bd->prev_in(max1));
+    holes = width() - s;
+    ModEvent me;
+    if (assigned())
+      me = ME_INT_VAL;
+    else if ((min1 == dom.min()) && (max1 == dom.max()))
+      me = ME_INT_DOM;
+    else
+      me = ME_INT_BND;
+    IntDelta d;
+    return notify(home,me,d);
+  }
+
+
   /*
    * Copying variables
    *
@@ -319,7 +418,18 @@ namespace Gecode { namespace Int {
   IntVarImp::IntVarImp(Space& home, bool share, IntVarImp& x)
     : IntVarImpBase(home,share,x), dom(x.dom.min(),x.dom.max()) {
     holes = x.holes;
-    if (holes) {
+    if (holes && x.bits()) {
+      // Only copy the words between the bounds
+      const unsigned int bpb = Support::BitSetData::bpb;
+      const BitDom* s = x.bitdom();
+      unsigned int w_min = static_cast<unsigned int>(dom.min()-s->o) / bpb;
+      unsigned int w_max = static_cast<unsigned int>(dom.max()-s->o) / bpb;
+      BitDom* d = BitDom::allocate(home,s->o+static_cast<int>(w_min*bpb),
+                                   w_max-w_min+1);
+      for (unsigned int i=w_min; i<=w_max; i++)
+        d->b[i-w_min] = s->b[i];
+      fst(NULL); bitdom(d);
+    } else if (holes) {
       int m = 1;
       // Compute length
       {
@@ -347,7 +457,7 @@ namespace Gecode { namespace Int {
       } while (s_c != NULL);
       d_c->next(NULL,NULL);
     } else {
-      fst(NULL);
+      fst(NULL); lst(NULL);
     }
   }
 
@@ -158,6 +158,142 @@ namespace Gecode { namespace Int {
 #undef GECODE_INT_RL2PD
 #undef GECODE_INT_PD2RL
 
+  /*
+   * Bitsets for small domains
+   *
+   */
+
+  forceinline IntVarImp::BitDom*
+  IntVarImp::BitDom::allocate(Space& home, int o, unsigned int n) {
+    assert(n > 0);
+    BitDom* bd = static_cast<BitDom*>
+      (home.ralloc(sizeof(BitDom)+(n-1)*sizeof(Support::BitSetData)));
+    bd->o = o;
+    for (unsigned int i=n; i--; )
+      bd->b[i].init(false);
+    return bd;
+  }
+
+  forceinline bool
+  IntVarImp::BitDom::get(int v) const {
+    unsigned int i = static_cast<unsigned int>(v-o);
+    return b[i / Support::BitSetData::bpb].get(i % Support::BitSetData::bpb);
+  }
+
+  forceinline void
+  IntVarImp::BitDom::clear(int v) {
+    unsigned int i = static_cast<unsigned int>(v-o);
+    b[i / Support::BitSetData::bpb].clear(i % Support::BitSetData::bpb);
+  }
+
+  forceinline void
+  IntVarImp::BitDom::set(int l, int h) {
+    for (unsigned int i = static_cast<unsigned int>(l-o);
+         i <= static_cast<unsigned int>(h-o); i++)
+      b[i / Support::BitSetData::bpb].set(i % Support::BitSetData::bpb);
+  }
+
+  forceinline int
+  IntVarImp::BitDom::next_in(int v) const {
+    const unsigned int bpb = Support::BitSetData::bpb;
+    unsigned int i = static_cast<unsigned int>(v-o);
+    unsigned int w = i / bpb;
+    if (b[w](i % bpb))
+      return o + static_cast<int>(w*bpb + b[w].next(i % bpb));
+    do {
+      w++;
+    } while (b[w].none());
+    return o + static_cast<int>(w*bpb + b[w].next(0));
+  }
+
+  forceinline int
+  IntVarImp::BitDom::prev_in(int v) const {
+    const unsigned int bpb = Support::BitSetData::bpb;
+    unsigned int i = static_cast<unsigned int>(v-o);
+    unsigned int w = i / bpb;
+    unsigned int j = i % bpb;
+    if ((j+1 == bpb) ? !b[w].none() : !b[w].none(j+1))
+      return o + static_cast<int>(w*bpb + b[w].prev(j));
+    do {
+      assert(w > 0);
+      w--;
+    } while (b[w].none());
+    return o + static_cast<int>(w*bpb + b[w].prev(bpb-1));
+  }
+
+  forceinline int
+  IntVarImp::BitDom::next_out(int v, int u) const {
+    const unsigned int bpb = Support::BitSetData::bpb;
+    unsigned int i = static_cast<unsigned int>(v-o);
+    unsigned int iu = static_cast<unsigned int>(u-o);
+    unsigned int w = i / bpb;
+    Support::BitSetData n = Support::BitSetData::neg(b[w]);
+    if (n(i % bpb)) {
+      i = w*bpb + n.next(i % bpb);
+    } else {
+      i = iu+1;
+      while (++w <= iu / bpb) {
+        n = Support::BitSetData::neg(b[w]);
+        if (!n.none()) {
+          i = w*bpb + n.next(0); break;
+        }
+      }
+    }
+    return o + static_cast<int>(std::min(i,iu+1));
+  }
+
+  forceinline int
+  IntVarImp::BitDom::prev_out(int v, int l) const {
+    const unsigned int bpb = Support::BitSetData::bpb;
+    unsigned int i = static_cast<unsigned int>(v-o);
+    unsigned int il = static_cast<unsigned int>(l-o);
+    unsigned int w = i / bpb;
+    unsigned int j = i % bpb;
+    Support::BitSetData n = Support::BitSetData::neg(b[w]);
+    if ((j+1 == bpb) ? !n.none() : !n.none(j+1)) {
+      int p = static_cast<int>(w*bpb + n.prev(j));
+      return o + std::max(p,static_cast<int>(il)-1);
+    }
+    while (w-- > il / bpb) {
+      n = Support::BitSetData::neg(b[w]);
+      if (!n.none()) {
+        int p = static_cast<int>(w*bpb + n.prev(bpb-1));
+        return o + std::max(p,static_cast<int>(il)-1);
+      }
+    }
+    return l-1;
+  }
+
+  forceinline unsigned int
+  IntVarImp::BitDom::count(Support::BitSetData w,
+                           unsigned int l, unsigned int h) {
+    Support::BitSetData x = w;
+    if (h+1 < Support::BitSetData::bpb)
+      x.a(w,h+1);
+    unsigned int c = x.count();
+    if (l > 0) {
+      Support::BitSetData y = w;
+      y.a(w,l);
+      c -= y.count();
+    }
+    return c;
+  }
+
+  forceinline unsigned int
+  IntVarImp::BitDom::count(int l, int h) const {
+    const unsigned int bpb = Support::BitSetData::bpb;
+    unsigned int il = static_cast<unsigned int>(l-o);
+    unsigned int ih = static_cast<unsigned int>(h-o);
+    unsigned int wl = il / bpb;
+    unsigned int wh = ih / bpb;
+    if (wl == wh)
+      return count(b[wl],il % bpb,ih % bpb);
+    unsigned int c = count(b[wl],il % bpb,bpb-1);
+    for (unsigned int w=wl+1; w<wh; w++)
+      c += b[w].count();
+    return c + count(b[wh],0,ih % bpb);
+  }
+
   /*
    * Mainitaining range lists for variable domain
    *
@@ -183,6 +319,21 @@ namespace Gecode { namespace Int {
     _lst = l;
   }
 
+  forceinline bool
+  IntVarImp::bits(void) const {
+    return Support::marked(_lst);
+  }
+
+  forceinline IntVarImp::BitDom*
+  IntVarImp::bitdom(void) const {
+    return static_cast<BitDom*>(Support::unmark(_lst));
+  }
+
+  forceinline void
+  IntVarImp::bitdom(BitDom* bd) {
+    _lst = static_cast<RangeList*>(Support::mark(bd));
+  }
+
   /*
    * Creation of new variable implementations
    *
@@ -190,12 +341,19 @@ namespace Gecode { namespace Int {
 
   forceinline
   IntVarImp::IntVarImp(Space& home, int min, int max)
-    : IntVarImpBase(home), dom(min,max,NULL,NULL), holes(0) {}
+    : IntVarImpBase(home), dom(min,max,NULL,NULL), _lst(NULL), holes(0) {}
 
   forceinline
   IntVarImp::IntVarImp(Space& home, const IntSet& d)
-    : IntVarImpBase(home), dom(d.min(),d.max()) {
-    if (d.ranges() > 1) {
+    : IntVarImpBase(home), dom(d.min(),d.max()), _lst(NULL) {
+    if ((d.ranges() > 1) && (dom.width() <= bits_max)) {
+      BitDom* bd = BitDom::allocate
+        (home,d.min(),Support::BitSetData::data(dom.width()));
+      for (int i=0; i<d.ranges(); i++)
+        bd->set(d.min(i),d.max(i));
+      fst(NULL); bitdom(bd);
+      holes = dom.width() - d.size();
+    } else if (d.ranges() > 1) {
       int n = d.ranges();
       assert(n >= 2);
       RangeList* r = home.alloc<RangeList>(n);
@@ -240,7 +398,7 @@ namespace Gecode { namespace Int {
 
   forceinline bool
   IntVarImp::range(void) const {
-    return fst() == NULL;
+    return holes == 0;
   }
   forceinline bool
   IntVarImp::assigned(void) const {
@@ -260,8 +418,11 @@ namespace Gecode { namespace Int {
 
   forceinline unsigned int
   IntVarImp::regret_min(void) const {
-    if (fst() == NULL) {
+    if (range()) {
       return (dom.min() == dom.max()) ? 0U : 1U;
+    } else if (bits()) {
+      return static_cast<unsigned int>(bitdom()->next_in(dom.min()+1)-
+                                       dom.min());
     } else if (dom.min() == fst()->max()) {
       return static_cast<unsigned int>(fst()->next(NULL)->min()-dom.min());
     } else {
@@ -270,8 +431,11 @@ namespace Gecode { namespace Int {
   }
   forceinline unsigned int
   IntVarImp::regret_max(void) const {
-    if (fst() == NULL) {
+    if (range()) {
       return (dom.min() == dom.max()) ? 0U : 1U;
+    } else if (bits()) {
+      return static_cast<unsigned int>(dom.max()-
+                                       bitdom()->prev_in(dom.max()-1));
     } else if (dom.max() == lst()->min()) {
       return static_cast<unsigned int>(dom.max()-lst()->prev(NULL)->max());
     } else {
@@ -290,13 +454,18 @@ namespace Gecode { namespace Int {
   IntVarImp::in(int n) const {
     if ((n < dom.min()) || (n > dom.max()))
       return false;
-    return (fst() == NULL) || in_full(n);
+    if (range())
+      return true;
+    return bits() ? bitdom()->get(n) : in_full(n);
   }
   forceinline bool
   IntVarImp::in(long long int n) const {
     if ((n < dom.min()) || (n > dom.max()))
       return false;
-    return (fst() == NULL) || in_full(static_cast<int>(n));
+    if (range())
+      return true;
+    return bits() ? bitdom()->get(static_cast<int>(n)) :
+      in_full(static_cast<int>(n));
   }
 
 
@@ -425,34 +594,51 @@ namespace Gecode { namespace Int {
 
   forceinline
   IntVarImpFwd::IntVarImpFwd(void) {}
-  forceinline
-  IntVarImpFwd::IntVarImpFwd(const IntVarImp* x)
-    : p(NULL), c(x->ranges_fwd()) {}
   forceinline void
   IntVarImpFwd::init(const IntVarImp* x) {
-    p=NULL; c=x->ranges_fwd();
+    if (x->bits()) {
+      b=x->bitdom(); u=x->max();
+      mi=x->min(); ma=b->next_out(mi,u)-1;
+    } else {
+      b=NULL; p=NULL; c=x->ranges_fwd();
+      mi=c->min(); ma=c->max();
+    }
+  }
+  forceinline
+  IntVarImpFwd::IntVarImpFwd(const IntVarImp* x) {
+    init(x);
   }
 
   forceinline bool
   IntVarImpFwd::operator ()(void) const {
-    return c != NULL;
+    return mi <= ma;
   }
   forceinline void
   IntVarImpFwd::operator ++(void) {
-    const IntVarImp::RangeList* n=c->next(p); p=c; c=n;
+    if (b == NULL) {
+      const IntVarImp::RangeList* n=c->next(p); p=c; c=n;
+      if (c != NULL) {
+        mi=c->min(); ma=c->max();
+        return;
+      }
+    } else if (ma < u) {
+      mi=b->next_in(ma+1); ma=b->next_out(mi,u)-1;
+      return;
+    }
+    mi=1; ma=0;
   }
 
   forceinline int
   IntVarImpFwd::min(void) const {
-    return c->min();
+    return mi;
   }
   forceinline int
   IntVarImpFwd::max(void) const {
-    return c->max();
+    return ma;
   }
   forceinline unsigned int
   IntVarImpFwd::width(void) const {
-    return c->width();
+    return static_cast<unsigned int>(ma-mi)+1;
   }
 
 
@@ -463,34 +649,51 @@ namespace Gecode { namespace Int {
 
   forceinline
   IntVarImpBwd::IntVarImpBwd(void) {}
-  forceinline
-  IntVarImpBwd::IntVarImpBwd(const IntVarImp* x)
-    : n(NULL), c(x->ranges_bwd()) {}
   forceinline void
   IntVarImpBwd::init(const IntVarImp* x) {
-    n=NULL; c=x->ranges_bwd();
+    if (x->bits()) {
+      b=x->bitdom(); l=x->min();
+      ma=x->max(); mi=b->prev_out(ma,l)+1;
+    } else {
+      b=NULL; n=NULL; c=x->ranges_bwd();
+      mi=c->min(); ma=c->max();
+    }
+  }
+  forceinline
+  IntVarImpBwd::IntVarImpBwd(const IntVarImp* x) {
+    init(x);
   }
 
   forceinline bool
   IntVarImpBwd::operator ()(void) const {
-    return c != NULL;
+    return mi <= ma;
   }
   forceinline void
   IntVarImpBwd::operator ++(void) {
-    const IntVarImp::RangeList* p=c->prev(n); n=c; c=p;
+    if (b == NULL) {
+      const IntVarImp::RangeList* p=c->prev(n); n=c; c=p;
+      if (c != NULL) {
+        mi=c->min(); ma=c->max();
+        return;
+      }
+    } else if (mi > l) {
+      ma=b->prev_in(mi-1); mi=b->prev_out(ma,l)+1;
+      return;
+    }
+    mi=1; ma=0;
   }
 
   forceinline int
   IntVarImpBwd::min(void) const {
-    return c->min();
+    return mi;
   }
   forceinline int
   IntVarImpBwd::max(void) const {
-    return c->max();
+    return ma;
   }
   forceinline unsigned int
   IntVarImpBwd::width(void) const {
-    return c->width();
+    return static_cast<unsigned int>(ma-mi)+1;
   }
 
 
@@ -515,7 +718,9 @@ namespace Gecode { namespace Int {
     if (!ri()) {
       // Remove possible rangelist (if it was not a range, the domain
       // must have been narrowed!)
-      if (fst()) {
+      if (bits()) {
+        lst(NULL); holes = 0;
+      } else if (fst()) {
         fst()->dispose(home,NULL,lst());
         fst(NULL); holes = 0;
       }
@@ -527,6 +732,9 @@ namespace Gecode { namespace Int {
       goto notify;
     }
 
+    if (bits() || (width() <= bits_max))
+      return narrow_bits(home,min0,max0,ri);
+
     if (depends || range()) {
       // Construct new rangelist
       RangeList*   f = new (home) RangeList(min0,max0,NULL,NULL);
@@ -704,6 +912,12 @@ namespace Gecode { namespace Int {
         (!i() || (i.min() > dom.max())))
       return gq(home,i_max+1);
 
+    if (bits() || (width() <= bits_max)) {
+      if (!bits())
+        tobits(home);
+      return minus_bits(home,i_min,i_max,i);
+    }
+
     // Set up two sentinel elements
     RangeList f, l;
     // Put all ranges between sentinels
@@ -870,6 +1084,23 @@ namespace Gecode { namespace Int {
     if (!i() || (i.val() > dom.max()))
       return nq_full(home,v);
 
+    if (bits() || (width() <= bits_max)) {
+      if (!bits())
+        tobits(home);
+      BitDom* bd = bitdom();
+      // Number of values removed
+      unsigned int h = 0;
+      do {
+        if (bd->get(v)) {
+          bd->clear(v); h++;
+        }
+        if (!i())
+          break;
+        v = i.val(); ++i;
+      } while (v <= dom.max());
+      return bits_removed(home,h);
+    }
+
     // Set up two sentinel elements
     RangeList f, l;
     // Put all ranges between sentinels
@@ -982,6 +1213,71 @@ namespace Gecode { namespace Int {
   }
 
 
+  template<class I>
+  forceinline ModEvent
+  IntVarImp::narrow_bits(Space& home, int min0, int max0, I& ri) {
+    assert(ri());
+    // Record new domain first as the iterator might depend on the domain
+    int o = bits() ? bitdom()->o : dom.min();
+    unsigned int n =
+      Support::BitSetData::data(static_cast<unsigned int>(dom.max()-o)+1);
+    Region r(home);
+    BitDom* t = static_cast<BitDom*>
+      (r.ralloc(sizeof(BitDom)+(n-1)*sizeof(Support::BitSetData)));
+    t->o = o;
+    for (unsigned int j=n; j--; )
+      t->b[j].init(false);
+    t->set(min0,max0);
+    unsigned int s = static_cast<unsigned int>(max0-min0+1);
+    do {
+      t->set(ri.min(),ri.max());
+      s += ri.width();
+      max0 = ri.max();
+      ++ri;
+    } while (ri());
+
+    // Check for modification
+    if (size() == s)
+      return ME_INT_NONE;
+
+    if (!bits()) {
+      if (fst() != NULL) {
+        fst()->dispose(home,NULL,lst());
+        fst(NULL);
+      }
+      bitdom(BitDom::allocate(home,o,n));
+    }
+    BitDom* bd = bitdom();
+    for (unsigned int j=n; j--; )
+      bd->b[j] = t->b[j];
+
+    ModEvent me = ((min0 == dom.min()) && (max0 == dom.max())) ?
+      ME_INT_DOM : ME_INT_BND;
+    dom.min(min0); dom.max(max0);
+    holes = width() - s;
+    IntDelta d;
+    return notify(home,me,d);
+  }
+
+  template<class I>
+  forceinline ModEvent
+  IntVarImp::minus_bits(Space& home, int i_min, int i_max, I& i) {
+    BitDom* bd = bitdom();
+    // Number of values removed
+    unsigned int h = 0;
+    while (true) {
+      for (int v=std::max(i_min,dom.min()); v<=std::min(i_max,dom.max()); v++)
+        if (bd->get(v)) {
+          bd->clear(v); h++;
+        }
+      if (!i() || (i.min() > dom.max()))
+        break;
+      i_min = i.min(); i_max = i.max(); ++i;
+    }
+    return bits_removed(home,h);
+  }
+
+
   /*
    * Copying a variable
    *
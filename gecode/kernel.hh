@@ -214,6 +214,7 @@ namespace Gecode {
 #include <gecode/kernel/branch-val.hpp>
 #include <gecode/kernel/brancher-merit.hpp>
 #include <gecode/kernel/brancher-view-sel.hpp>
+#include <gecode/kernel/brancher-view-sel-heap.hpp>
 #include <gecode/kernel/brancher-view.hpp>
 #include <gecode/kernel/brancher-val-sel.hpp>
 #include <gecode/kernel/brancher-val-commit.hpp>
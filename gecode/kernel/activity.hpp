@@ -68,10 +68,10 @@ namespace Gecode {
 
     /// Pointer to storage object
     Storage* storage;
-    /// Update activity value at position \a i
-    void update(int i);
-    /// Decay activity value at position \a i
-    void decay(int i);
+    /// Update activity value at position \a i (without locking if \a lf)
+    void update(int i, bool lf);
+    /// Decay activity value at position \a i (without locking if \a lf)
+    void decay(int i, bool lf);
     /// Acquire mutex
     void acquire(void);
     /// Release mutex
@@ -290,16 +290,22 @@ namespace Gecode {
    */
 
   forceinline void
-  Activity::update(int i) {
+  Activity::update(int i, bool lf) {
     assert(storage != NULL);
     assert((i >= 0) && (i < storage->n));
-    storage->a[i] += 1.0;
+    if (lf)
+      Support::atomic_add(storage->a[i],1.0);
+    else
+      storage->a[i] += 1.0;
   }
   forceinline void
-  Activity::decay(int i) {
+  Activity::decay(int i, bool lf) {
     assert(storage != NULL);
     assert((i >= 0) && (i < storage->n));
-    storage->a[i] *= storage->d;
+    if (lf)
+      Support::atomic_mul(storage->a[i],storage->d);
+    else
+      storage->a[i] *= storage->d;
   }
   forceinline double
   Activity::operator [](int i) const {
@@ -418,21 +424,24 @@ namespace Gecode {
   template<class View>
   ExecStatus
   Activity::Recorder<View>::propagate(Space& home, const ModEventDelta&) {
-    // Lock activity information
-    a.acquire();
+    // Lock activity information, unless values are updated lock-free
+    bool lf = home.afc_lockfree();
+    if (!lf)
+      a.acquire();
     for (Advisors<Idx> as(c); as(); ++as) {
       int i = as.advisor().idx();
       if (as.advisor().marked()) {
         as.advisor().unmark();
-        a.update(i);
+        a.update(i,lf);
         if (x[i].assigned())
           as.advisor().dispose(home,c);
       } else {
         assert(!x[i].assigned());
-        a.decay(i);
+        a.decay(i,lf);
       }
     }
-    a.release();
+    if (!lf)
+      a.release();
     return c.empty() ? home.ES_SUBSUMED(*this) : ES_FIX;
   }
 
@@ -57,6 +57,7 @@ namespace Gecode {
       _a = heap.realloc<unsigned int>(_a, _size, e._n);
       heap.copy<unsigned int>(_a,e._a,e._n);
       _size = _n = e._n;
+      _pos = e._pos;
     }
     return *this;
   }
@@ -65,6 +66,36 @@ namespace Gecode {
     heap.free<unsigned int>(_a,_size);
   }
 
+  /// Magic number identifying archives in binary format ("GCA1")
+  const unsigned int archive_magic = 0x47434131U;
+
+  void
+  Archive::write(std::ostream& os) const {
+    unsigned int h[2] = {archive_magic, static_cast<unsigned int>(_n)};
+    os.write(reinterpret_cast<const char*>(&h[0]),sizeof(h));
+    os.write(reinterpret_cast<const char*>(_a),
+             static_cast<std::streamsize>(_n*sizeof(unsigned int)));
+  }
+
+  bool
+  Archive::read(std::istream& is) {
+    unsigned int h[2];
+    if (!is.read(reinterpret_cast<char*>(&h[0]),sizeof(h)) ||
+        (h[0] != archive_magic) ||
+        (h[1] > 0x7fffffffU))
+      return false;
+    int n = static_cast<int>(h[1]);
+    unsigned int* a = heap.alloc<unsigned int>(n+1);
+    if (!is.read(reinterpret_cast<char*>(a),
+                 static_cast<std::streamsize>(n*sizeof(unsigned int)))) {
+      heap.free<unsigned int>(a,n+1);
+      return false;
+    }
+    heap.free<unsigned int>(_a,_size);
+    _a = a; _size = n+1; _n = n; _pos = 0;
+    return true;
+  }
+
 }
 
 // STATISTICS: kernel-branch
@@ -35,12 +35,16 @@
  *
  */
 
+#include <iostream>
+
 namespace Gecode {
   /**
    * \brief %Archive representation
    *
    * An Archive is an array of unsigned integers, used as an external
    * representation of internal data structures (such as Choice objects).
+   * Archives can be written to and read from streams in a compact
+   * binary format (for example, to checkpoint search engines).
    */
   class Archive {
   private:
@@ -71,6 +75,15 @@ namespace Gecode {
     unsigned int operator [](int i) const;
     /// Return next element to read
     unsigned int get(void);
+    /// Write contents in binary format to \a os
+    GECODE_KERNEL_EXPORT void write(std::ostream& os) const;
+    /**
+     * \brief Replace contents by archive in binary format read from \a is
+     *
+     * Returns false if \a is does not contain an archive written
+     * by Archive::write, in which case the contents remain unchanged.
+     */
+    GECODE_KERNEL_EXPORT bool read(std::istream& is);
   };
 
   /** Add \a i to the end of \a e
@@ -0,0 +1,646 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main author:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+
+  /**
+   * \brief Indexed heap of view positions ordered by merit
+   *
+   * The heap is a local object of a space so that it is copied
+   * together with the space. Positions of views that have been
+   * modified are recorded as dirty and are re-keyed (or removed
+   * when assigned) before the next selection.
+   *
+   * \ingroup TaskBranchViewSel
+   */
+  template<class Choose, class Val>
+  class ViewSelHeap : public LocalObject {
+  protected:
+    /// Number of views
+    int n;
+    /// The heap of view positions
+    int* h;
+    /// Number of entries in heap
+    int n_h;
+    /// Position of view in heap (-1 if not in heap)
+    int* p;
+    /// Merit value for views
+    Val* v;
+    /// Stack of dirty view positions
+    int* d;
+    /// Number of dirty view positions
+    int n_d;
+    /// Whether a view position is dirty
+    bool* m;
+    /// Whether view at position \a i is better than view at position \a j
+    bool better(int i, int j) const;
+    /// Move heap entry at \a k upwards
+    void up(int k);
+    /// Move heap entry at \a k downwards
+    void down(int k);
+    /// Constructor for cloning \a vsh
+    ViewSelHeap(Space& home, bool share, ViewSelHeap& vsh);
+  public:
+    /// Constructor for \a n views
+    ViewSelHeap(Space& home, int n);
+    /// Create copy during cloning
+    virtual Actor* copy(Space& home, bool share);
+    /// Insert view at position \a i with merit \a mi
+    void insert(int i, Val mi);
+    /// Update merit of view at position \a i to \a mi
+    void update(int i, Val mi);
+    /// Remove view at position \a i
+    void remove(int i);
+    /// Mark view at position \a i as dirty
+    void mark(int i);
+    /// Return a dirty view position and unmark it, -1 if there is none
+    int dirty(void);
+    /// Return position of best view
+    int top(void) const;
+    /// Store in \a t the \a n positions of views as good as the best view
+    void ties(int* t, int& n) const;
+  };
+
+  /// Handle for heap of view positions
+  template<class Choose, class Val>
+  class ViewSelHeapHandle : public LocalHandle {
+  public:
+    /// Create handle pointing to no heap
+    ViewSelHeapHandle(void);
+    /// Create handle pointing to heap \a vsh
+    ViewSelHeapHandle(ViewSelHeap<Choose,Val>* vsh);
+    /// Whether handle points to a heap
+    bool initialized(void) const;
+    /// Access to heap
+    ViewSelHeap<Choose,Val>& heap(void) const;
+    /// Updating during cloning
+    void update(Space& home, bool share, ViewSelHeapHandle& vshh);
+  };
+
+  /**
+   * \brief Propagator for tracking view modifications for a heap
+   *
+   * The propagator never prunes: its advisors only mark the
+   * positions of modified views as dirty in the heap.
+   *
+   * \ingroup TaskBranchViewSel
+   */
+  template<class View, class Choose, class Val>
+  class ViewSelHeapTracker : public NaryPropagator<View,PC_GEN_NONE> {
+  protected:
+    using NaryPropagator<View,PC_GEN_NONE>::x;
+    /// Advisor with view position
+    class Idx : public Advisor {
+    protected:
+      /// Position of view
+      int _idx;
+    public:
+      /// Constructor for creation
+      Idx(Space& home, Propagator& p, Council<Idx>& c, int i);
+      /// Constructor for cloning \a a
+      Idx(Space& home, bool share, Idx& a);
+      /// Get position of view
+      int idx(void) const;
+    };
+    /// The heap to be informed about modifications
+    ViewSelHeapHandle<Choose,Val> h;
+    /// The advisor council
+    Council<Idx> c;
+    /// Constructor for cloning \a p
+    ViewSelHeapTracker(Space& home, bool share, ViewSelHeapTracker& p);
+  public:
+    /// Constructor for creation
+    ViewSelHeapTracker(Home home, ViewArray<View>& x,
+                       ViewSelHeapHandle<Choose,Val>& h);
+    /// Copy propagator during cloning
+    virtual Propagator* copy(Space& home, bool share);
+    /// Cost function (record so that propagator runs last)
+    virtual PropCost cost(const Space& home, const ModEventDelta& med) const;
+    /// Schedule function
+    virtual void reschedule(Space& home);
+    /// Give advice to propagator
+    virtual ExecStatus advise(Space& home, Advisor& a, const Delta& d);
+    /// Perform propagation
+    virtual ExecStatus propagate(Space& home, const ModEventDelta& med);
+    /// Delete propagator and return its size
+    virtual size_t dispose(Space& home);
+  };
+
+  /**
+   * \brief Choose view according to merit using a heap
+   *
+   * The merit of a view must only depend on its domain (such as its
+   * size, minimum, maximum, or regret). Instead of scanning all views
+   * for each selection, the views are kept in a heap that is only
+   * updated for views that have been modified since the last
+   * selection. The heap is created when a view is selected for the
+   * first time and only if there are at least \a n_heap unassigned
+   * views, otherwise views are scanned as by ViewSelChoose.
+   *
+   * Ties are broken by selecting the view with the smallest position,
+   * hence the same view as with ViewSelChoose is selected.
+   *
+   * \ingroup TaskBranchViewSel
+   */
+  template<class Choose, class Merit>
+  class ViewSelChooseHeap : public ViewSelChoose<Choose,Merit> {
+  protected:
+    typedef typename ViewSelChoose<Choose,Merit>::Val Val;
+    typedef typename ViewSelChoose<Choose,Merit>::View View;
+    using ViewSelChoose<Choose,Merit>::m;
+    /// Status of the heap
+    enum HeapStatus {
+      HS_NONE,   ///< Heap has not been created yet
+      HS_USE,    ///< Heap has been created and is used
+      HS_SCAN    ///< Too few views, views are scanned
+    };
+    /// Status of the heap
+    HeapStatus hs;
+    /// The heap
+    ViewSelHeapHandle<Choose,Val> h;
+    /// Create the heap if needed and update dirty views, return whether heap is used
+    bool heap(Space& home, ViewArray<View>& x, int s);
+  public:
+    /// Minimal number of unassigned views for which a heap is created
+    static const int n_heap = 256;
+    /// \name Initialization
+    //@{
+    /// Constructor for creation
+    ViewSelChooseHeap(Space& home, const VarBranch& vb);
+    /// Constructor for copying during cloning
+    ViewSelChooseHeap(Space& home, bool shared,
+                      ViewSelChooseHeap<Choose,Merit>& vs);
+    //@}
+    /// \name View selection and tie breaking
+    //@{
+    /// Select a view from \a x starting from \a s and return its position
+    virtual int select(Space& home, ViewArray<View>& x, int s);
+    /// Select ties from \a x starting from \a s
+    virtual void ties(Space& home, ViewArray<View>& x, int s,
+                      int* ties, int& n);
+    using ViewSelChoose<Choose,Merit>::select;
+    using ViewSelChoose<Choose,Merit>::ties;
+    //@}
+  };
+
+  /// Select view with least merit using a heap
+  template<class Merit>
+  class ViewSelMinHeap : public ViewSelChooseHeap<ChooseMin,Merit> {
+    typedef typename ViewSelChooseHeap<ChooseMin,Merit>::View View;
+  public:
+    /// \name Initialization
+    //@{
+    /// Constructor for initialization
+    ViewSelMinHeap(Space& home, const VarBranch& vb);
+    /// Constructor for copying during cloning
+    ViewSelMinHeap(Space& home, bool shared, ViewSelMinHeap<Merit>& vs);
+    //@}
+    /// \name Resource management and cloning
+    //@{
+    /// Create copy during cloning
+    virtual ViewSel<View>* copy(Space& home, bool shared);
+    //@}
+  };
+
+  /// Select view with largest merit using a heap
+  template<class Merit>
+  class ViewSelMaxHeap : public ViewSelChooseHeap<ChooseMax,Merit> {
+    typedef typename ViewSelChooseHeap<ChooseMax,Merit>::View View;
+  public:
+    /// \name Initialization
+    //@{
+    /// Constructor for initialization
+    ViewSelMaxHeap(Space& home, const VarBranch& vb);
+    /// Constructor for copying during cloning
+    ViewSelMaxHeap(Space& home, bool shared, ViewSelMaxHeap<Merit>& vs);
+    //@}
+    /// \name Resource management and cloning
+    //@{
+    /// Create copy during cloning
+    virtual ViewSel<View>* copy(Space& home, bool shared);
+    //@}
+  };
+
+
+  /*
+   * Heap of view positions
+   *
+   */
+  template<class Choose, class Val>
+  forceinline
+  ViewSelHeap<Choose,Val>::ViewSelHeap(Space& home, int n0)
+    : LocalObject(home), n(n0),
+      h(home.alloc<int>(n)), n_h(0), p(home.alloc<int>(n)),
+      v(home.alloc<Val>(n)), d(home.alloc<int>(n)), n_d(0),
+      m(home.alloc<bool>(n)) {
+    for (int i=n; i--; ) {
+      p[i]=-1; m[i]=false;
+    }
+  }
+
+  template<class Choose, class Val>
+  forceinline
+  ViewSelHeap<Choose,Val>::ViewSelHeap(Space& home, bool share,
+                                       ViewSelHeap& vsh)
+    : LocalObject(home,share,vsh), n(vsh.n),
+      h(home.alloc<int>(n)), n_h(vsh.n_h), p(home.alloc<int>(n)),
+      v(home.alloc<Val>(n)), d(home.alloc<int>(n)), n_d(vsh.n_d),
+      m(home.alloc<bool>(n)) {
+    for (int i=n_h; i--; )
+      h[i]=vsh.h[i];
+    for (int i=n_d; i--; )
+      d[i]=vsh.d[i];
+    for (int i=n; i--; ) {
+      p[i]=vsh.p[i]; v[i]=vsh.v[i]; m[i]=vsh.m[i];
+    }
+  }
+
+  template<class Choose, class Val>
+  Actor*
+  ViewSelHeap<Choose,Val>::copy(Space& home, bool share) {
+    return new (home) ViewSelHeap<Choose,Val>(home,share,*this);
+  }
+
+  template<class Choose, class Val>
+  forceinline bool
+  ViewSelHeap<Choose,Val>::better(int i, int j) const {
+    Choose c;
+    return c(v[i],v[j]) || (!c(v[j],v[i]) && (i < j));
+  }
+
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeap<Choose,Val>::up(int k) {
+    int i = h[k];
+    while (k > 0) {
+      int u = (k-1) >> 1;
+      if (!better(i,h[u]))
+        break;
+      h[k]=h[u]; p[h[k]]=k; k=u;
+    }
+    h[k]=i; p[i]=k;
+  }
+
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeap<Choose,Val>::down(int k) {
+    int i = h[k];
+    while (true) {
+      int l = 2*k+1;
+      if (l >= n_h)
+        break;
+      if ((l+1 < n_h) && better(h[l+1],h[l]))
+        l++;
+      if (!better(h[l],i))
+        break;
+      h[k]=h[l]; p[h[k]]=k; k=l;
+    }
+    h[k]=i; p[i]=k;
+  }
+
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeap<Choose,Val>::insert(int i, Val mi) {
+    assert(p[i] < 0);
+    v[i]=mi; h[n_h]=i; up(n_h++);
+  }
+
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeap<Choose,Val>::update(int i, Val mi) {
+    assert(p[i] >= 0);
+    v[i]=mi; up(p[i]); down(p[i]);
+  }
+
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeap<Choose,Val>::remove(int i) {
+    int k = p[i];
+    if (k < 0)
+      return;
+    p[i]=-1;
+    if (k == --n_h)
+      return;
+    // Move last entry to position k and restore heap property
+    int j = h[n_h];
+    h[k]=j; p[j]=k;
+    up(k); down(p[j]);
+  }
+
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeap<Choose,Val>::mark(int i) {
+    if (!m[i]) {
+      m[i]=true; d[n_d++]=i;
+    }
+  }
+
+  template<class Choose, class Val>
+  forceinline int
+  ViewSelHeap<Choose,Val>::dirty(void) {
+    if (n_d == 0)
+      return -1;
+    int i = d[--n_d];
+    m[i]=false;
+    return i;
+  }
+
+  template<class Choose, class Val>
+  forceinline int
+  ViewSelHeap<Choose,Val>::top(void) const {
+    assert(n_h > 0);
+    return h[0];
+  }
+
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeap<Choose,Val>::ties(int* t, int& n_t) const {
+    Choose c;
+    Val b = v[h[0]];
+    // Collect all entries that are not worse than the best entry
+    n_t=0; t[n_t++]=h[0];
+    for (int j=0; j<n_t; j++) {
+      int k = 2*p[t[j]]+1;
+      for (int l=k; (l < k+2) && (l < n_h); l++)
+        if (!c(b,v[h[l]]))
+          t[n_t++]=h[l];
+    }
+    // Sort ties by position as views are scanned by position
+    Support::quicksort<int>(t,n_t);
+  }
+
+
+  /*
+   * Handle for heap of view positions
+   *
+   */
+  template<class Choose, class Val>
+  forceinline
+  ViewSelHeapHandle<Choose,Val>::ViewSelHeapHandle(void) {}
+  template<class Choose, class Val>
+  forceinline
+  ViewSelHeapHandle<Choose,Val>::
+  ViewSelHeapHandle(ViewSelHeap<Choose,Val>* vsh)
+    : LocalHandle(vsh) {}
+  template<class Choose, class Val>
+  forceinline bool
+  ViewSelHeapHandle<Choose,Val>::initialized(void) const {
+    return object() != NULL;
+  }
+  template<class Choose, class Val>
+  forceinline ViewSelHeap<Choose,Val>&
+  ViewSelHeapHandle<Choose,Val>::heap(void) const {
+    return *static_cast<ViewSelHeap<Choose,Val>*>(object());
+  }
+  template<class Choose, class Val>
+  forceinline void
+  ViewSelHeapHandle<Choose,Val>::update(Space& home, bool share,
+                                        ViewSelHeapHandle& vshh) {
+    if (vshh.initialized())
+      LocalHandle::update(home,share,vshh);
+  }
+
+
+  /*
+   * Tracker propagator
+   *
+   */
+  template<class View, class Choose, class Val>
+  forceinline
+  ViewSelHeapTracker<View,Choose,Val>::Idx::Idx(Space& home, Propagator& p,
+                                                Council<Idx>& c, int i)
+    : Advisor(home,p,c), _idx(i) {}
+  template<class View, class Choose, class Val>
+  forceinline
+  ViewSelHeapTracker<View,Choose,Val>::Idx::Idx(Space& home, bool share,
+                                                Idx& a)
+    : Advisor(home,share,a), _idx(a._idx) {}
+  template<class View, class Choose, class Val>
+  forceinline int
+  ViewSelHeapTracker<View,Choose,Val>::Idx::idx(void) const {
+    return _idx;
+  }
+
+  template<class View, class Choose, class Val>
+  forceinline
+  ViewSelHeapTracker<View,Choose,Val>::
+  ViewSelHeapTracker(Home home, ViewArray<View>& x,
+                     ViewSelHeapHandle<Choose,Val>& h0)
+    : NaryPropagator<View,PC_GEN_NONE>(home,x), h(h0), c(home) {
+    for (int i=x.size(); i--; )
+      if (!x[i].assigned())
+        x[i].subscribe(home,*new (home) Idx(home,*this,c,i));
+  }
+
+  template<class View, class Choose, class Val>
+  forceinline
+  ViewSelHeapTracker<View,Choose,Val>::
+  ViewSelHeapTracker(Space& home, bool share, ViewSelHeapTracker& p)
+    : NaryPropagator<View,PC_GEN_NONE>(home,share,p) {
+    h.update(home,share,p.h);
+    c.update(home,share,p.c);
+  }
+
+  template<class View, class Choose, class Val>
+  Propagator*
+  ViewSelHeapTracker<View,Choose,Val>::copy(Space& home, bool share) {
+    return new (home) ViewSelHeapTracker<View,Choose,Val>(home,share,*this);
+  }
+
+  template<class View, class Choose, class Val>
+  inline size_t
+  ViewSelHeapTracker<View,Choose,Val>::dispose(Space& home) {
+    // Cancel remaining advisors
+    for (Advisors<Idx> as(c); as(); ++as)
+      x[as.advisor().idx()].cancel(home,as.advisor());
+    c.dispose(home);
+    (void) NaryPropagator<View,PC_GEN_NONE>::dispose(home);
+    return sizeof(*this);
+  }
+
+  template<class View, class Choose, class Val>
+  PropCost
+  ViewSelHeapTracker<View,Choose,Val>::cost(const Space&,
+                                            const ModEventDelta&) const {
+    return PropCost::record();
+  }
+
+  template<class View, class Choose, class Val>
+  void
+  ViewSelHeapTracker<View,Choose,Val>::reschedule(Space& home) {
+    if (c.empty())
+      View::schedule(home,*this,ME_GEN_ASSIGNED);
+  }
+
+  template<class View, class Choose, class Val>
+  ExecStatus
+  ViewSelHeapTracker<View,Choose,Val>::advise(Space& home, Advisor& a,
+                                              const Delta&) {
+    int i = static_cast<Idx&>(a).idx();
+    h.heap().mark(i);
+    if (x[i].assigned()) {
+      a.dispose(home,c);
+      // Run propagator only to be subsumed when no view is left
+      return c.empty() ? ES_NOFIX : ES_FIX;
+    }
+    return ES_FIX;
+  }
+
+  template<class View, class Choose, class Val>
+  ExecStatus
+  ViewSelHeapTracker<View,Choose,Val>::propagate(Space& home,
+                                                 const ModEventDelta&) {
+    return c.empty() ? home.ES_SUBSUMED(*this) : ES_FIX;
+  }
+
+
+  /*
+   * Choose view according to merit using a heap
+   *
+   */
+  template<class Choose, class Merit>
+  forceinline
+  ViewSelChooseHeap<Choose,Merit>::ViewSelChooseHeap(Space& home,
+                                                     const VarBranch& vb)
+    : ViewSelChoose<Choose,Merit>(home,vb), hs(HS_NONE) {}
+
+  template<class Choose, class Merit>
+  forceinline
+  ViewSelChooseHeap<Choose,Merit>::
+  ViewSelChooseHeap(Space& home, bool shared,
+                    ViewSelChooseHeap<Choose,Merit>& vs)
+    : ViewSelChoose<Choose,Merit>(home,shared,vs), hs(vs.hs) {
+    h.update(home,shared,vs.h);
+  }
+
+  template<class Choose, class Merit>
+  bool
+  ViewSelChooseHeap<Choose,Merit>::heap(Space& home, ViewArray<View>& x,
+                                        int s) {
+    switch (hs) {
+    case HS_NONE:
+      {
+        int n = 0;
+        for (int i=s; i<x.size(); i++)
+          if (!x[i].assigned())
+            n++;
+        if (n < n_heap) {
+          hs = HS_SCAN;
+          return false;
+        }
+        h = ViewSelHeapHandle<Choose,Val>
+          (new (home) ViewSelHeap<Choose,Val>(home,x.size()));
+        for (int i=s; i<x.size(); i++)
+          if (!x[i].assigned())
+            h.heap().insert(i,m(home,x[i],i));
+        (void) new (home) ViewSelHeapTracker<View,Choose,Val>(home,x,h);
+        hs = HS_USE;
+        return true;
+      }
+    case HS_USE:
+      for (int i; (i = h.heap().dirty()) >= 0; )
+        if (x[i].assigned())
+          h.heap().remove(i);
+        else
+          h.heap().update(i,m(home,x[i],i));
+      return true;
+    case HS_SCAN:
+      return false;
+    default: GECODE_NEVER;
+    }
+    return false;
+  }
+
+  template<class Choose, class Merit>
+  int
+  ViewSelChooseHeap<Choose,Merit>::select(Space& home, ViewArray<View>& x,
+                                          int s) {
+    if (!heap(home,x,s))
+      return ViewSelChoose<Choose,Merit>::select(home,x,s);
+    assert(!x[h.heap().top()].assigned());
+    return h.heap().top();
+  }
+
+  template<class Choose, class Merit>
+  void
+  ViewSelChooseHeap<Choose,Merit>::ties(Space& home, ViewArray<View>& x,
+                                        int s, int* ties, int& n) {
+    if (!heap(home,x,s))
+      return ViewSelChoose<Choose,Merit>::ties(home,x,s,ties,n);
+    h.heap().ties(ties,n);
+    assert(n > 0);
+  }
+
+
+  template<class Merit>
+  forceinline
+  ViewSelMinHeap<Merit>::ViewSelMinHeap(Space& home, const VarBranch& vb)
+    : ViewSelChooseHeap<ChooseMin,Merit>(home,vb) {}
+
+  template<class Merit>
+  forceinline
+  ViewSelMinHeap<Merit>::ViewSelMinHeap(Space& home, bool shared,
+                                        ViewSelMinHeap<Merit>& vs)
+    : ViewSelChooseHeap<ChooseMin,Merit>(home,shared,vs) {}
+
+  template<class Merit>
+  ViewSel<typename ViewSelMinHeap<Merit>::View>*
+  ViewSelMinHeap<Merit>::copy(Space& home, bool shared) {
+    return new (home) ViewSelMinHeap<Merit>(home,shared,*this);
+  }
+
+
+  template<class Merit>
+  forceinline
+  ViewSelMaxHeap<Merit>::ViewSelMaxHeap(Space& home, const VarBranch& vb)
+    : ViewSelChooseHeap<ChooseMax,Merit>(home,vb) {}
+
+  template<class Merit>
+  forceinline
+  ViewSelMaxHeap<Merit>::ViewSelMaxHeap(Space& home, bool shared,
+                                        ViewSelMaxHeap<Merit>& vs)
+    : ViewSelChooseHeap<ChooseMax,Merit>(home,shared,vs) {}
+
+  template<class Merit>
+  ViewSel<typename ViewSelMaxHeap<Merit>::View>*
+  ViewSelMaxHeap<Merit>::copy(Space& home, bool shared) {
+    return new (home) ViewSelMaxHeap<Merit>(home,shared,*this);
+  }
+
+}
+
+// STATISTICS: kernel-branch
@@ -646,6 +646,15 @@ namespace Gecode {
   Space::constrain(const Space&) {
   }
 
+  bool
+  Space::objective(int&) const {
+    return false;
+  }
+
+  void
+  Space::improve(int) {
+  }
+
   bool
   Space::master(const MetaInfo& mi) {
     switch (mi.type()) {
@@ -1958,6 +1958,32 @@ namespace Gecode {
      * \ingroup TaskModelScript
      */
     GECODE_KERNEL_EXPORT virtual void constrain(const Space& best);
+    /**
+     * \brief Objective function for best solution search
+     *
+     * A space for which betterness is defined by a single integer
+     * objective can return the objective value to be minimized in
+     * \a o and return true. Then parallel best solution search can
+     * share the bound of the so far best solution as an integer and
+     * use improve() instead of constrain(). The value must be
+     * smaller than the largest integer.
+     *
+     * The default function returns false.
+     *
+     * \ingroup TaskModelScript
+     */
+    GECODE_KERNEL_EXPORT virtual bool objective(int& o) const;
+    /**
+     * \brief Improve function for best solution search
+     *
+     * Must constrain this space to have an objective value (as
+     * returned by objective()) less than \a o.
+     *
+     * The default function does nothing.
+     *
+     * \ingroup TaskModelScript
+     */
+    GECODE_KERNEL_EXPORT virtual void improve(int o);
     /**
      * \brief Master configuration function for meta search engines
      *
@@ -2599,6 +2625,17 @@ namespace Gecode {
     /// Reset AFC to \a a
     GECODE_KERNEL_EXPORT
     void afc_set(double a);
+    /**
+     * \brief %Set whether AFC and activity information is updated without locking
+     *
+     * The setting is shared by all spaces cloned from the same space
+     * and is meant for parallel search, where all workers update the
+     * same information. It has no effect if the platform does not
+     * support atomic operations.
+     */
+    void afc_lockfree(bool b);
+    /// Return whether AFC and activity information is updated without locking
+    bool afc_lockfree(void) const;
     //@}
 
   private:
@@ -3277,6 +3314,16 @@ namespace Gecode {
     return gpi.decay();
   }
 
+  forceinline void
+  Space::afc_lockfree(bool b) {
+    gpi.lockfree(b);
+  }
+
+  forceinline bool
+  Space::afc_lockfree(void) const {
+    return gpi.lockfree();
+  }
+
   forceinline size_t
   Actor::dispose(Space&) {
     return sizeof(*this);
@@ -83,6 +83,10 @@ namespace Gecode {
       double dpow[n_dpow];
       /// The global time-stamp
       unsigned long int t;
+      /// Whether counters are updated without locking
+      bool lf;
+      /// Return decay factor for \a n time steps
+      double dpower(unsigned long int n) const;
       /// Decay counter value
       void decay(Info& c);
     public:
@@ -100,6 +104,14 @@ namespace Gecode {
       void set(Info& c, double a);
       /// Return counter value
       double val(Info& c);
+      /// Increment counter without locking
+      void inc_lockfree(Info& c);
+      /// Return counter value without locking
+      double val_lockfree(const Info& c) const;
+      /// Whether counters are updated without locking
+      bool lockfree(void) const;
+      /// Set whether counters are updated without locking
+      void lockfree(bool b);
     };
     /// Initial smallest number of entries per block
     static const unsigned int size_min = 32;
@@ -156,6 +168,10 @@ namespace Gecode {
     double afc(Info& c);
     /// Allocate new actor info
     Info* allocate(unsigned int gid);
+    /// Whether failure counts are updated without locking
+    bool lockfree(void) const;
+    /// Set whether failure counts are updated without locking
+    void lockfree(bool b);
   };
 
 
@@ -178,7 +194,7 @@ namespace Gecode {
   }
   forceinline
   GPI::Manager::Manager(void)
-    : next(0), d(1.0), t(0UL) {}
+    : next(0), d(1.0), t(0UL), lf(false) {}
 
   forceinline unsigned int
   GPI::Manager::pid(void) {
@@ -188,16 +204,17 @@ namespace Gecode {
   GPI::Manager::decay(void) const {
     return d;
   }
+  forceinline double
+  GPI::Manager::dpower(unsigned long int n) const {
+    assert((n > 0) && (d != 1.0));
+    return (n <= n_dpow) ? dpow[n-1] : pow(d,static_cast<double>(n));
+  }
   forceinline void
   GPI::Manager::decay(Info& c) {
     assert((t >= c.t) && (d != 1.0));
     unsigned int n = t - c.t;
     if (n > 0) {
-      if (n <= n_dpow) {
-        c.c *= dpow[n-1];
-      } else {
-        c.c *= pow(d,static_cast<double>(n));
-      }
+      c.c *= dpower(n);
       c.t = t;
     }
   }
@@ -221,6 +238,55 @@ namespace Gecode {
     c.c = a;
   }
 
+  /*
+   * Lock-free counters
+   *
+   * The global time-stamp and the counter values are updated by
+   * atomic operations only. Concurrent increments of the same counter
+   * might apply a decay step twice or not at all, which is acceptable
+   * for a heuristic value. Reading a counter applies the decay but
+   * does not store the decayed value.
+   *
+   */
+  forceinline void
+  GPI::Manager::inc_lockfree(Info& c) {
+    if (d == 1.0) {
+      Support::atomic_add(c.c,1.0);
+    } else {
+      unsigned long int n = Support::atomic_inc(t);
+      double o = Support::atomic_load(c.c);
+      double v;
+      do {
+        unsigned long int ct = Support::atomic_load(c.t);
+        v = ((ct+1 < n) ? o * dpower(n-1-ct) : o) + 1.0;
+      } while (!Support::atomic_cas(c.c,o,v));
+      Support::atomic_store(c.t,n);
+    }
+  }
+  forceinline double
+  GPI::Manager::val_lockfree(const Info& c) const {
+    double v = Support::atomic_load(c.c);
+    if (d != 1.0) {
+      unsigned long int ct = Support::atomic_load(c.t);
+      unsigned long int n = Support::atomic_load(t);
+      if (n > ct)
+        v *= dpower(n-ct);
+    }
+    return v;
+  }
+  forceinline bool
+  GPI::Manager::lockfree(void) const {
+    return lf;
+  }
+  forceinline void
+  GPI::Manager::lockfree(bool b) {
+#ifdef GECODE_HAS_ATOMICS
+    lf = b;
+#else
+    (void) b;
+#endif
+  }
+
 
   /*
    * Global AFC information
@@ -310,6 +376,10 @@ namespace Gecode {
 
   forceinline void
   GPI::fail(Info& c) {
+    if (object()->manager->lockfree()) {
+      object()->manager->inc_lockfree(c);
+      return;
+    }
     Support::FastMutex& m = *object()->mutex;
     m.acquire();
     object()->manager->inc(c);
@@ -326,6 +396,8 @@ namespace Gecode {
 
   forceinline double
   GPI::afc(Info& c) {
+    if (object()->manager->lockfree())
+      return object()->manager->val_lockfree(c);
     Support::FastMutex& m = *object()->mutex;
     double d;
     m.acquire();
@@ -380,6 +452,19 @@ namespace Gecode {
     return c;
   }
 
+  forceinline bool
+  GPI::lockfree(void) const {
+    return object()->manager->lockfree();
+  }
+
+  forceinline void
+  GPI::lockfree(bool b) {
+    Support::FastMutex& m = *object()->mutex;
+    m.acquire();
+    object()->manager->lockfree(b);
+    m.release();
+  }
+
 }
 
 // STATISTICS: kernel-prop
@@ -2213,6 +2213,12 @@ namespace Gecode {
     /// Member function constraining according to decreasing cost
     GECODE_MINIMODEL_EXPORT
     virtual void constrain(const Space& best);
+    /// Return the cost as objective value
+    GECODE_MINIMODEL_EXPORT
+    virtual bool objective(int& o) const;
+    /// Member function constraining cost to be less than \a o
+    GECODE_MINIMODEL_EXPORT
+    virtual void improve(int o);
     /// Return variable with current cost
     virtual IntVar cost(void) const = 0;
   };
@@ -2230,6 +2236,12 @@ namespace Gecode {
     /// Member function constraining according to increasing cost
     GECODE_MINIMODEL_EXPORT
     virtual void constrain(const Space& best);
+    /// Return the negated cost as objective value
+    GECODE_MINIMODEL_EXPORT
+    virtual bool objective(int& o) const;
+    /// Member function constraining cost to be greater than -\a o
+    GECODE_MINIMODEL_EXPORT
+    virtual void improve(int o);
     /// Return variable with current cost
     virtual IntVar cost(void) const = 0;
   };
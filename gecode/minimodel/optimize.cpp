@@ -48,6 +48,17 @@ namespace Gecode {
     rel(*this, cost(), IRT_LE, best->cost().val());
   }
 
+  bool
+  IntMinimizeSpace::objective(int& o) const {
+    o = cost().val();
+    return true;
+  }
+
+  void
+  IntMinimizeSpace::improve(int o) {
+    rel(*this, cost(), IRT_LE, o);
+  }
+
 
   void
   IntMaximizeSpace::constrain(const Space& _best) {
@@ -58,6 +69,18 @@ namespace Gecode {
     rel(*this, cost(), IRT_GR, best->cost().val());
   }
 
+  bool
+  IntMaximizeSpace::objective(int& o) const {
+    // Integer limits are symmetric, so negation cannot overflow
+    o = -cost().val();
+    return true;
+  }
+
+  void
+  IntMaximizeSpace::improve(int o) {
+    rel(*this, cost(), IRT_GR, -o);
+  }
+
 
 #ifdef GECODE_HAS_FLOAT_VARS
 
@@ -109,11 +109,28 @@ namespace Gecode { namespace Search {
     const unsigned int c_d = 8;
     /// Create a clone during recomputation if distance is greater than \a a_d (adaptive distance)
     const unsigned int a_d = 2;
+    /// Commit distance for which both distances are adapted during search
+    const unsigned int c_d_auto = 0;
+    /// Largest commit distance chosen by adaptation
+    const unsigned int c_d_max = 64;
+    /// Number of nodes after which distances are adapted
+    const unsigned long int c_d_period = 128;
 
     /// Minimal number of open nodes for stealing
     const unsigned int steal_limit = 3;
     /// Initial delay in milliseconds for all but first worker thread
     const unsigned int initial_delay = 5;
+    /// Initial number of spin iterations an idle worker backs off
+    const unsigned int steal_backoff_min = 16;
+    /// Maximal number of spin iterations before an idle worker sleeps
+    const unsigned int steal_backoff_max = 4096;
+    /// Minimal number of subproblems per worker for embarrassingly parallel search
+    const unsigned int eps_subproblems = 30;
+
+    /// Whether parallel engines update AFC and activity information without locking
+    const bool afc_lockfree = false;
+    /// Whether parallel depth-first and branch-and-bound search is deterministic
+    const bool deterministic = false;
 
     /// Default discrepancy limit for LDS
     const unsigned int d_l = 5;
@@ -149,6 +166,10 @@ namespace Gecode { namespace Search {
     unsigned long int restart;
     /// Number of no-goods posted
     unsigned long int nogood;
+    /// Commit distance (as adapted for Config::c_d_auto)
+    unsigned long int c_d;
+    /// Adaptive distance (as adapted for Config::c_d_auto)
+    unsigned long int a_d;
     /// Initialize
     Statistics(void);
     /// Reset
@@ -449,7 +470,7 @@ namespace Gecode { namespace Search {
       bool clone;
       /// Number of threads to use
       double threads;
-      /// Create a clone after every \a c_d commits (commit distance)
+      /// Create a clone after every \a c_d commits (commit distance, Config::c_d_auto for adaptation)
       unsigned int c_d;
       /// Create a clone during recomputation if distance is greater than \a a_d (adaptive distance)
       unsigned int a_d;
@@ -459,6 +480,10 @@ namespace Gecode { namespace Search {
       bool share_rbs;
       /// Whether to share AFC information among assets in a portfolio
       bool share_pbs;
+      /// Whether AFC and activity information is updated without locking by parallel engines
+      bool afc_lockfree;
+      /// Whether parallel depth-first and branch-and-bound search is deterministic
+      bool deterministic;
       /// Number of assets (engines) in a portfolio
       unsigned int assets;
       /// Size of a slice in a portfolio (in number of failures)
@@ -612,6 +637,10 @@ namespace Gecode { namespace Search {
     virtual void reset(Space* s);
     /// Return no-goods (the no-goods are empty)
     virtual NoGoods& nogoods(void);
+    /// Archive state of engine in \a a (raises exception)
+    virtual void checkpoint(Archive& a) const;
+    /// Restore state of engine from \a a and return best solution (raises exception)
+    virtual Space* restore(Archive& a);
     /// Destructor
     virtual ~Engine(void);
   };
@@ -641,6 +670,30 @@ namespace Gecode { namespace Search {
     virtual Statistics statistics(void) const;
     /// Check whether engine has been stopped
     virtual bool stopped(void) const;
+    /**
+     * \brief Archive the state of the engine in \a a
+     *
+     * The state comprises the statistics, the choices and alternatives
+     * on the current path of the search tree, and (for best solution
+     * search) the paths to all solutions found so far. Spaces are
+     * not archived: they are recomputed from the root space when the
+     * state is restored.
+     *
+     * Only sequential depth-first and branch-and-bound search support
+     * checkpointing, other engines throw Search::NoCheckpoint.
+     */
+    virtual void checkpoint(Archive& a) const;
+    /**
+     * \brief Restore state of the engine from checkpoint \a a
+     *
+     * The engine must have been created for the same model and with
+     * the same options as the engine that has been checkpointed, and
+     * next() must not have been called yet. Returns the best solution
+     * found before the checkpoint (or NULL). Throws
+     * Search::IllegalCheckpoint if \a a has not been created by an
+     * engine of the same type.
+     */
+    virtual T* restore(Archive& a);
     /// Destructor
     virtual ~Base(void);
   private:
@@ -805,6 +858,11 @@ namespace Gecode {
 
   /**
    * \brief Limited discrepancy search engine
+   *
+   * If more than one thread is requested, the probes for different
+   * discrepancies are run in parallel. Solutions are returned in the
+   * same order as with a single thread.
+   *
    * \ingroup TaskModelSearch
    */
   template<class T>
@@ -831,6 +889,89 @@ namespace Gecode {
  
 #include <gecode/search/lds.hpp>
 
+namespace Gecode {
+
+  /**
+   * \brief Distributed search engine
+   *
+   * The search tree is explored by worker processes (as many as
+   * threads are given by the options \a o) that are created when the
+   * engine is created. Master and workers exchange subproblems and
+   * solutions as archived choices leading from the root to them, so
+   * all choices of \a T must support archiving (as all choices of
+   * the predefined branchers do). Whether all solutions or best
+   * solutions are searched for is defined by the engine \a E (for
+   * example, DFS or BAB).
+   *
+   * Workers are created by forking the calling process, so the
+   * engine should be created before threads (for example, by
+   * other search engines) are started. Options that cannot be
+   * transferred to the workers (stop objects and no-goods) only
+   * take effect in the calling process. On platforms without
+   * process support the engine performs sequential or parallel
+   * search instead.
+   *
+   * \ingroup TaskModelSearch
+   */
+  template<class T, template<class> class E = DFS>
+  class Distributed : public Search::Base<T> {
+  public:
+    /// Initialize engine for space \a s and options \a o
+    Distributed(T* s, const Search::Options& o=Search::Options::def);
+    /// Whether engine does best solution search
+    static const bool best = E<T>::best;
+  };
+
+  /**
+   * \brief Perform distributed search for subclass \a T of space \a s and options \a o
+   * \ingroup TaskModelSearch
+   */
+  template<class T, template<class> class E>
+  T* distributed(T* s, const Search::Options& o=Search::Options::def);
+
+}
+
+#include <gecode/search/distributed.hpp>
+
+namespace Gecode {
+
+  /**
+   * \brief Embarrassingly parallel search engine
+   *
+   * The root space \a s is first decomposed by breadth-first
+   * exploration into at least Search::Config::eps_subproblems
+   * subproblems per thread. Only subproblems that survive propagation
+   * are kept, and each is described by the commits leading to it from
+   * the root. Worker threads take subproblems from a shared queue and
+   * explore them with the sequential engine \a E (for example, DFS or
+   * BAB).
+   *
+   * \ingroup TaskModelSearch
+   */
+  template<class T, template<class> class E = DFS>
+  class EPS : public Search::Base<T> {
+  public:
+    /// Initialize engine for space \a s and options \a o
+    EPS(T* s, const Search::Options& o=Search::Options::def);
+    /// Whether engine does best solution search
+    static const bool best = E<T>::best;
+  };
+
+  /**
+   * \brief Perform embarrassingly parallel search for subclass \a T of space \a s and options \a o
+   * \ingroup TaskModelSearch
+   */
+  template<class T, template<class> class E>
+  T* eps(T* s, const Search::Options& o=Search::Options::def);
+
+  /// Return an embarrassingly parallel search engine builder
+  template<class T, template<class> class E>
+  SEB eps(const Search::Options& o=Search::Options::def);
+
+}
+
+#include <gecode/search/eps.hpp>
+
 namespace Gecode {
 
   /**
@@ -61,6 +61,16 @@ namespace Gecode { namespace Search {
     return e->stopped();
   }
   template<class T>
+  forceinline void
+  Base<T>::checkpoint(Archive& a) const {
+    e->checkpoint(a);
+  }
+  template<class T>
+  forceinline T*
+  Base<T>::restore(Archive& a) {
+    return dynamic_cast<T*>(e->restore(a));
+  }
+  template<class T>
   forceinline
   Base<T>::~Base(void) {
     delete e;
@@ -39,6 +39,7 @@
 #include <gecode/search/sequential/dfs.hh>
 #ifdef GECODE_HAS_THREADS
 #include <gecode/search/parallel/dfs.hh>
+#include <gecode/search/parallel/eps.hh>
 #endif
 #include <gecode/search/support.hh>
 
@@ -50,6 +51,8 @@ namespace Gecode { namespace Search {
     Options to = o.expand();
     if (to.threads == 1.0)
       return new WorkerToEngine<Sequential::DFS>(s,to);
+    else if (to.deterministic)
+      return new Parallel::EPS(s,to,false);
     else
       return new Parallel::DFS(s,to);
 #else
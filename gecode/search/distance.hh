@@ -0,0 +1,185 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_SEARCH_DISTANCE_HH__
+#define __GECODE_SEARCH_DISTANCE_HH__
+
+#include <gecode/search.hh>
+
+#include <cmath>
+
+namespace Gecode { namespace Search {
+
+  /**
+   * \brief Commit and adaptive distance for recomputation
+   *
+   * If the commit distance in the options is Config::c_d_auto, both
+   * distances are adapted during search. The model for adaptation
+   * assumes that a clone at every \f$c\f$-th node costs \f$C/c\f$
+   * per node, whereas recomputation after a failure costs on average
+   * \f$c/2\f$ commits, each as expensive as propagating a node. With
+   * a failure rate of \f$f\f$ and propagation cost \f$P\f$ per node, the
+   * best distance is \f$\sqrt{2C/(fP)}\f$.
+   *
+   * The cost for cloning and for propagation are measured as wall-clock
+   * time for nodes reached by committing (not by recomputation).
+   */
+  class Distance {
+  protected:
+    /// Current commit distance
+    unsigned int _c_d;
+    /// Current adaptive distance
+    unsigned int _a_d;
+    /// Whether distances are adapted
+    bool adaptive;
+    /// Timer for measuring cost
+    Support::Timer t;
+    /// Accumulated time for cloning
+    double t_clone;
+    /// Number of clones measured
+    unsigned long int n_clone;
+    /// Accumulated time for propagating nodes
+    double t_node;
+    /// Number of nodes measured
+    unsigned long int n_node;
+    /// Number of nodes explored since last adaptation
+    unsigned long int n_all;
+    /// Number of failures since last adaptation
+    unsigned long int n_fail;
+    /// Adapt distances
+    void adapt(void);
+  public:
+    /// Initialize from options \a o
+    Distance(const Options& o);
+    /// Return commit distance
+    unsigned int c_d(void) const;
+    /// Return adaptive distance
+    unsigned int a_d(void) const;
+    /// Record current distances in statistics \a stat
+    void statistics(Statistics& stat) const;
+    /// Return a clone of \a s
+    Space* clone(Space& s);
+    /// Perform propagation for \a s (recomputed if \a r) with statistics \a stat
+    SpaceStatus status(Space& s, bool r, Statistics& stat);
+  };
+
+
+  forceinline
+  Distance::Distance(const Options& o)
+    : _c_d(o.c_d), _a_d(o.a_d), adaptive(o.c_d == Config::c_d_auto),
+      t_clone(0.0), n_clone(0UL), t_node(0.0), n_node(0UL),
+      n_all(0UL), n_fail(0UL) {
+    if (adaptive) {
+      _c_d = Config::c_d;
+      _a_d = Config::a_d;
+    }
+  }
+
+  forceinline unsigned int
+  Distance::c_d(void) const {
+    return _c_d;
+  }
+  forceinline unsigned int
+  Distance::a_d(void) const {
+    return _a_d;
+  }
+
+  forceinline void
+  Distance::statistics(Statistics& stat) const {
+    stat.c_d = _c_d; stat.a_d = _a_d;
+  }
+
+  forceinline void
+  Distance::adapt(void) {
+    if ((n_clone > 0UL) && (n_node > 0UL) && (t_node > 0.0)) {
+      double c = t_clone / n_clone;
+      double p = t_node / n_node;
+      double f = static_cast<double>(n_fail) / n_all;
+      double d = (f > 0.0) ? std::sqrt(2.0 * c / (f * p)) :
+        static_cast<double>(Config::c_d_max);
+      // Move halfway towards the new distance
+      d = (d + _c_d) / 2.0;
+      if (d < 1.0)
+        _c_d = 1U;
+      else if (d > static_cast<double>(Config::c_d_max))
+        _c_d = Config::c_d_max;
+      else
+        _c_d = static_cast<unsigned int>(d + 0.5);
+      _a_d = std::max(Config::a_d, _c_d / 2U);
+      // Keep half of the measurements as history
+      t_clone /= 2.0; n_clone >>= 1;
+      t_node /= 2.0; n_node >>= 1;
+    }
+    n_all = 0UL; n_fail = 0UL;
+  }
+
+  forceinline Space*
+  Distance::clone(Space& s) {
+    if (!adaptive)
+      return s.clone();
+    t.start();
+    Space* c = s.clone();
+    t_clone += t.stop();
+    n_clone++;
+    return c;
+  }
+
+  forceinline SpaceStatus
+  Distance::status(Space& s, bool r, Statistics& stat) {
+    if (!adaptive)
+      return s.status(stat);
+    SpaceStatus ss;
+    if (r) {
+      ss = s.status(stat);
+    } else {
+      t.start();
+      ss = s.status(stat);
+      t_node += t.stop();
+      n_node++;
+    }
+    if (ss == SS_FAILED)
+      n_fail++;
+    if (++n_all >= Config::c_d_period)
+      adapt();
+    return ss;
+  }
+
+}}
+
+#endif
+
+// STATISTICS: search-other
@@ -0,0 +1,138 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/search/distributed/channel.hh>
+
+#ifdef GECODE_HAS_DISTRIBUTED
+
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace Gecode { namespace Search { namespace Distributed {
+
+  /// Send \a n bytes from \a b to socket \a fd
+  static bool
+  send_all(int fd, const char* b, size_t n) {
+    while (n > 0) {
+      ssize_t m = ::send(fd, b, n, MSG_NOSIGNAL);
+      if (m < 0) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      b += m; n -= static_cast<size_t>(m);
+    }
+    return true;
+  }
+
+  /// Receive \a n bytes from socket \a fd into \a b
+  static bool
+  receive_all(int fd, char* b, size_t n) {
+    while (n > 0) {
+      ssize_t m = ::recv(fd, b, n, 0);
+      if (m < 0) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      if (m == 0)
+        return false;
+      b += m; n -= static_cast<size_t>(m);
+    }
+    return true;
+  }
+
+  bool
+  Channel::send(const Archive& a) {
+    int n = a.size();
+    unsigned int* w = heap.alloc<unsigned int>(n+1);
+    w[0] = static_cast<unsigned int>(n);
+    for (int i=0; i<n; i++)
+      w[i+1] = a[i];
+    bool s = send_all(fd, reinterpret_cast<const char*>(w),
+                      (n+1)*sizeof(unsigned int));
+    heap.free<unsigned int>(w,n+1);
+    return s;
+  }
+
+  bool
+  Channel::receive(Archive& a) {
+    unsigned int n;
+    if (!receive_all(fd, reinterpret_cast<char*>(&n), sizeof(n)))
+      return false;
+    unsigned int* w = heap.alloc<unsigned int>(n);
+    bool r = receive_all(fd, reinterpret_cast<char*>(w),
+                         n*sizeof(unsigned int));
+    if (r) {
+      a = Archive();
+      for (unsigned int i=0; i<n; i++)
+        a << w[i];
+    }
+    heap.free<unsigned int>(w,n);
+    return r;
+  }
+
+  bool
+  Channel::pending(void) const {
+    struct pollfd p;
+    p.fd = fd; p.events = POLLIN; p.revents = 0;
+    int n;
+    do {
+      n = ::poll(&p, 1, 0);
+    } while ((n < 0) && (errno == EINTR));
+    return (n > 0) && (p.revents != 0);
+  }
+
+  void
+  Channel::close(void) {
+    if (fd >= 0)
+      (void) ::close(fd);
+    fd = -1;
+  }
+
+}}}
+
+#endif
+
+// STATISTICS: search-distributed
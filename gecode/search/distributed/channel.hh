@@ -0,0 +1,115 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_SEARCH_DISTRIBUTED_CHANNEL_HH__
+#define __GECODE_SEARCH_DISTRIBUTED_CHANNEL_HH__
+
+#include <gecode/search.hh>
+
+#if defined(GECODE_HAS_UNISTD_H) && !defined(_WIN32)
+#define GECODE_HAS_DISTRIBUTED
+#endif
+
+#ifdef GECODE_HAS_DISTRIBUTED
+
+namespace Gecode { namespace Search { namespace Distributed {
+
+  /// Tags for messages exchanged between master and workers
+  enum Tag {
+    /// Explore subproblem (master to worker)
+    T_WORK,
+    /// Split off a subproblem (master to worker)
+    T_STEAL,
+    /// New best solution (master to worker)
+    T_BEST,
+    /// Solution found (worker to master)
+    T_SOLUTION,
+    /// Subproblem split off (worker to master)
+    T_SPLIT,
+    /// No subproblem can be split off (worker to master)
+    T_NOWORK,
+    /// Exploration of subproblem finished (worker to master)
+    T_IDLE
+  };
+
+  /**
+   * \brief Channel between master and a worker process
+   *
+   * A message is an archive which is sent as its number of words
+   * followed by the words themselves.
+   */
+  class Channel {
+  protected:
+    /// File descriptor of socket
+    int fd;
+  public:
+    /// Initialize as closed channel
+    Channel(void);
+    /// Initialize with socket \a s
+    void init(int s);
+    /// Return file descriptor
+    int descriptor(void) const;
+    /// Send archive \a a, return false if peer is gone
+    bool send(const Archive& a);
+    /// Receive archive \a a (blocking), return false if peer is gone
+    bool receive(Archive& a);
+    /// Test whether a message is available
+    bool pending(void) const;
+    /// Close channel
+    void close(void);
+  };
+
+  forceinline
+  Channel::Channel(void) : fd(-1) {}
+
+  forceinline void
+  Channel::init(int s) {
+    fd = s;
+  }
+
+  forceinline int
+  Channel::descriptor(void) const {
+    return fd;
+  }
+
+}}}
+
+#endif
+
+#endif
+
+// STATISTICS: search-distributed
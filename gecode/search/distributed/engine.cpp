@@ -0,0 +1,502 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/search/distributed/engine.hh>
+
+#ifdef GECODE_HAS_DISTRIBUTED
+
+#include <gecode/search/sequential/path.hh>
+
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+namespace Gecode { namespace Search { namespace Distributed {
+
+  /// How many nodes are explored before checking for messages
+  const unsigned int poll_nodes = 16;
+  /// How many milliseconds the engine waits for messages before checking stop
+  const int poll_timeout = 10;
+
+  /*
+   * Worker
+   *
+   */
+  Worker::Worker(const Space& r, const Options& o, bool b, Channel& c)
+    : opt(o), bab(b), root(r), chan(c), path(0), cur(NULL), best(NULL),
+      d(0), dist(opt), mark(0), n_base(0) {}
+
+  bool
+  Worker::send(Tag t) {
+    Archive m;
+    m << t;
+    archive(m);
+    return chan.send(m);
+  }
+
+  bool
+  Worker::send(Tag t, int n, const Archive& e) {
+    Archive m;
+    m << t;
+    archive(m);
+    m << (n_base + n);
+    for (int i=0; i<base.size(); i++)
+      m << base[i];
+    for (int i=0; i<e.size(); i++)
+      m << e[i];
+    return chan.send(m);
+  }
+
+  void
+  Worker::work(Archive& m) {
+    // The message consists of the tag, the number of edges, and the edges
+    n_base = static_cast<int>(m[1]);
+    base = Archive();
+    for (int i=2; i<m.size(); i++)
+      base << m[i];
+    cur = Sequential::Path::replay(m,root);
+    if (best != NULL)
+      cur->constrain(*best);
+    d = 0; mark = 0;
+  }
+
+  void
+  Worker::better(Archive& m) {
+    Space* b = Sequential::Path::replay(m,root);
+    if (b->status() != SS_SOLVED) {
+      delete b;
+      return;
+    }
+    // Ignore solutions that are not better than the own best solution
+    if (best != NULL) {
+      b->constrain(*best);
+      if (b->status() == SS_FAILED) {
+        delete b;
+        return;
+      }
+      delete best;
+    }
+    best = b;
+    mark = path.entries();
+    if (cur != NULL)
+      cur->constrain(*best);
+  }
+
+  bool
+  Worker::handle(Archive& m) {
+    int t; m >> t;
+    switch (t) {
+    case T_STEAL:
+      {
+        Archive e;
+        int n = path.steal(e);
+        return (n > 0) ? send(T_SPLIT,n,e) : send(T_NOWORK);
+      }
+    case T_BEST:
+      better(m);
+      return true;
+    default:
+      // Subproblems are only handed out to idle workers
+      GECODE_NEVER;
+    }
+    return false;
+  }
+
+  bool
+  Worker::explore(void) {
+    bool r = true;
+    unsigned int p = 0;
+    while (true) {
+      if (++p == poll_nodes) {
+        p = 0;
+        while (chan.pending()) {
+          Archive m;
+          if (!chan.receive(m) || !handle(m))
+            return false;
+        }
+      }
+      while (cur == NULL) {
+        if (path.empty())
+          return true;
+        cur = bab ? path.recompute(d,dist.a_d(),*this,*best,mark)
+          : path.recompute(d,dist.a_d(),*this);
+        r = true;
+        if (cur != NULL)
+          break;
+        path.next();
+      }
+      node++;
+      switch (dist.status(*cur,r,*this)) {
+      case SS_FAILED:
+        fail++;
+        delete cur;
+        cur = NULL;
+        path.next();
+        break;
+      case SS_SOLVED:
+        {
+          // Deletes all pending branchers
+          (void) cur->choice();
+          // The path points to the solution
+          Archive e;
+          int n = path.archive(e);
+          if (!send(T_SOLUTION,n,e))
+            return false;
+          if (bab) {
+            delete best;
+            best = cur;
+          } else {
+            delete cur;
+          }
+          cur = NULL;
+          path.next();
+          mark = path.entries();
+        }
+        break;
+      case SS_BRANCH:
+        {
+          Space* c;
+          if ((d == 0) || (d >= dist.c_d())) {
+            c = dist.clone(*cur);
+            d = 1;
+          } else {
+            c = NULL;
+            d++;
+          }
+          const Choice* ch = path.push(*this,cur,c);
+          cur->commit(*ch,0);
+        }
+        break;
+      default:
+        GECODE_NEVER;
+      }
+      r = false;
+    }
+    GECODE_NEVER;
+    return false;
+  }
+
+  void
+  Worker::run(void) {
+    Archive m;
+    while (chan.receive(m)) {
+      if (m[0] == static_cast<unsigned int>(T_WORK)) {
+        int t; m >> t;
+        work(m);
+        if (!explore() || !send(T_IDLE))
+          return;
+      } else if (!handle(m)) {
+        return;
+      }
+    }
+  }
+
+  Worker::~Worker(void) {
+    delete cur;
+    delete best;
+    path.reset(0);
+  }
+
+
+  /*
+   * Engine
+   *
+   */
+
+  /// Return number of words used for archiving statistics
+  static int
+  stat_words(void) {
+    Archive a;
+    Search::Worker w;
+    w.archive(a);
+    return a.size();
+  }
+
+  Engine::Engine(Space* s, const Options& o, bool b)
+    : opt(o), bab(b), root(NULL), best(NULL), n_workers(0),
+      chan(NULL), pid(NULL), stat(NULL), busy(NULL), stealing(NULL),
+      pool(heap), solutions(heap), _stopped(false) {
+    if ((s == NULL) || (s->status(root_stat) == SS_FAILED)) {
+      root_stat.fail++;
+      if (!o.clone)
+        delete s;
+      return;
+    }
+    root = snapshot(s,opt);
+    unsigned int n = static_cast<unsigned int>(opt.threads);
+    chan = heap.alloc<Channel>(n);
+    pid = heap.alloc<pid_t>(n);
+    stat = heap.alloc<Search::Worker>(n);
+    busy = heap.alloc<bool>(n);
+    stealing = heap.alloc<bool>(n);
+    for (unsigned int i=0; i<n; i++) {
+      int sv[2];
+      if (::socketpair(AF_UNIX,SOCK_STREAM,0,sv) != 0)
+        break;
+      pid_t p = ::fork();
+      if (p < 0) {
+        (void) ::close(sv[0]); (void) ::close(sv[1]);
+        break;
+      }
+      if (p == 0) {
+        // Worker process: only keep its end of its own channel
+        for (unsigned int j=0; j<i; j++)
+          chan[j].close();
+        (void) ::close(sv[0]);
+        Channel c;
+        c.init(sv[1]);
+        {
+          Worker w(*root,opt,bab,c);
+          w.run();
+        }
+        c.close();
+        // Never return into the code of the calling process
+        ::_exit(0);
+      }
+      (void) ::close(sv[1]);
+      chan[i].init(sv[0]);
+      pid[i] = p;
+      busy[i] = stealing[i] = false;
+      n_workers++;
+    }
+    if (n_workers == 0) {
+      heap.free<Channel>(chan,n);
+      heap.free<pid_t>(pid,n);
+      heap.free<Search::Worker>(stat,n);
+      heap.free<bool>(busy,n);
+      heap.free<bool>(stealing,n);
+      delete root;
+      throw WorkerFailure("Distributed::Engine::Engine");
+    }
+    // The entire search tree is described by the empty path
+    Archive* a = new Archive;
+    *a << 0;
+    pool.push(a);
+  }
+
+  void
+  Engine::send(unsigned int i, const Archive& m) {
+    if (!chan[i].send(m))
+      throw WorkerFailure("Distributed::Engine::send");
+  }
+
+  void
+  Engine::solution(unsigned int i, Archive& m, int p) {
+    Space* s = Sequential::Path::replay(m,*root);
+    if (best != NULL)
+      s->constrain(*best);
+    if (s->status() != SS_SOLVED) {
+      // Not better than the best solution found so far
+      delete s;
+      return;
+    }
+    // Deletes all pending branchers
+    (void) s->choice();
+    if (bab) {
+      delete best;
+      best = s->clone(false);
+      // Announce better solution to all other workers
+      Archive b;
+      b << T_BEST;
+      for (int j=p; j<m.size(); j++)
+        b << m[j];
+      for (unsigned int j=0; j<n_workers; j++)
+        if (j != i)
+          send(j,b);
+    }
+    solutions.push(s);
+  }
+
+  void
+  Engine::handle(unsigned int i, Archive& m) {
+    int t; m >> t;
+    stat[i].unarchive(m);
+    // Position where the path starts (if any)
+    int p = 1 + stat_words();
+    switch (t) {
+    case T_SOLUTION:
+      solution(i,m,p);
+      break;
+    case T_SPLIT:
+      {
+        Archive* a = new Archive;
+        for (int j=p; j<m.size(); j++)
+          *a << m[j];
+        pool.push(a);
+        stealing[i] = false;
+      }
+      break;
+    case T_NOWORK:
+      stealing[i] = false;
+      break;
+    case T_IDLE:
+      busy[i] = false;
+      break;
+    default:
+      GECODE_NEVER;
+    }
+  }
+
+  void
+  Engine::dispatch(void) {
+    // Hand out subproblems to idle workers
+    for (unsigned int i=0; (i<n_workers) && !pool.empty(); i++)
+      if (!busy[i]) {
+        Archive* a = pool.pop();
+        Archive m;
+        m << T_WORK;
+        for (int j=0; j<a->size(); j++)
+          m << (*a)[j];
+        delete a;
+        send(i,m);
+        busy[i] = true;
+      }
+    if (!pool.empty())
+      return;
+    // Ask as many busy workers for subproblems as there are idle workers
+    unsigned int n_idle = 0, n_steal = 0;
+    for (unsigned int i=0; i<n_workers; i++) {
+      if (!busy[i])
+        n_idle++;
+      if (stealing[i])
+        n_steal++;
+    }
+    for (unsigned int i=0; (i<n_workers) && (n_steal < n_idle); i++)
+      if (busy[i] && !stealing[i]) {
+        Archive m;
+        m << T_STEAL;
+        send(i,m);
+        stealing[i] = true;
+        n_steal++;
+      }
+  }
+
+  void
+  Engine::receive(void) {
+    struct pollfd* p = heap.alloc<struct pollfd>(n_workers);
+    for (unsigned int i=0; i<n_workers; i++) {
+      p[i].fd = chan[i].descriptor();
+      p[i].events = POLLIN;
+      p[i].revents = 0;
+    }
+    int n = ::poll(p,n_workers,poll_timeout);
+    if ((n < 0) && (errno != EINTR)) {
+      heap.free<struct pollfd>(p,n_workers);
+      throw WorkerFailure("Distributed::Engine::receive");
+    }
+    for (unsigned int i=0; (n > 0) && (i<n_workers); i++)
+      if (p[i].revents != 0) {
+        Archive m;
+        if (!chan[i].receive(m)) {
+          heap.free<struct pollfd>(p,n_workers);
+          throw WorkerFailure("Distributed::Engine::receive");
+        }
+        handle(i,m);
+      }
+    heap.free<struct pollfd>(p,n_workers);
+  }
+
+  bool
+  Engine::finished(void) const {
+    if (!pool.empty())
+      return false;
+    for (unsigned int i=0; i<n_workers; i++)
+      if (busy[i] || stealing[i])
+        return false;
+    return true;
+  }
+
+  Space*
+  Engine::next(void) {
+    _stopped = false;
+    if (root == NULL)
+      return NULL;
+    while (solutions.empty()) {
+      dispatch();
+      if (finished())
+        return NULL;
+      if ((opt.stop != NULL) && opt.stop->stop(statistics(),opt)) {
+        _stopped = true;
+        return NULL;
+      }
+      receive();
+    }
+    return solutions.pop();
+  }
+
+  Statistics
+  Engine::statistics(void) const {
+    Statistics s(root_stat);
+    for (unsigned int i=0; i<n_workers; i++)
+      s += stat[i];
+    return s;
+  }
+
+  bool
+  Engine::stopped(void) const {
+    return _stopped;
+  }
+
+  Engine::~Engine(void) {
+    // Closing the channels makes the workers terminate
+    for (unsigned int i=0; i<n_workers; i++)
+      chan[i].close();
+    for (unsigned int i=0; i<n_workers; i++)
+      while ((::waitpid(pid[i],NULL,0) < 0) && (errno == EINTR)) {}
+    if (root != NULL) {
+      unsigned int n = static_cast<unsigned int>(opt.threads);
+      heap.free<Channel>(chan,n);
+      heap.free<pid_t>(pid,n);
+      heap.free<Search::Worker>(stat,n);
+      heap.free<bool>(busy,n);
+      heap.free<bool>(stealing,n);
+    }
+    while (!pool.empty())
+      delete pool.pop();
+    while (!solutions.empty())
+      delete solutions.pop();
+    delete best;
+    delete root;
+  }
+
+}}}
+
+#endif
+
+// STATISTICS: search-distributed
@@ -0,0 +1,179 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_SEARCH_DISTRIBUTED_ENGINE_HH__
+#define __GECODE_SEARCH_DISTRIBUTED_ENGINE_HH__
+
+#include <gecode/search.hh>
+#include <gecode/search/distributed/channel.hh>
+
+#ifdef GECODE_HAS_DISTRIBUTED
+
+#include <gecode/search/support.hh>
+#include <gecode/search/worker.hh>
+#include <gecode/search/distance.hh>
+#include <gecode/search/parallel/path.hh>
+
+#include <sys/types.h>
+
+namespace Gecode { namespace Search { namespace Distributed {
+
+  /**
+   * \brief %Worker exploring subproblems in a separate process
+   *
+   * A subproblem is described by the choices and alternatives leading
+   * from the root to it. The worker keeps this description (the base)
+   * so that subproblems split off from its own path can again be
+   * described from the root.
+   */
+  class Worker : public Search::Worker {
+  protected:
+    /// Search options
+    Options opt;
+    /// Whether best solution search is performed
+    bool bab;
+    /// Root space
+    const Space& root;
+    /// Channel to master
+    Channel& chan;
+    /// Current path in search tree (relative to base)
+    Parallel::Path path;
+    /// Current space being explored
+    Space* cur;
+    /// Best solution found so far
+    Space* best;
+    /// Distance until next clone
+    unsigned int d;
+    /// Commit and adaptive distance
+    Distance dist;
+    /// Number of entries not yet constrained to be better
+    int mark;
+    /// Number of edges leading to the current subproblem
+    int n_base;
+    /// Archived edges leading to the current subproblem
+    Archive base;
+    /// Send message with tag \a t
+    bool send(Tag t);
+    /// Send message with tag \a t for base and \a n edges archived in \a e
+    bool send(Tag t, int n, const Archive& e);
+    /// Start exploring subproblem from message \a m
+    void work(Archive& m);
+    /// Accept better solution from message \a m
+    void better(Archive& m);
+    /// Handle steal and best messages \a m
+    bool handle(Archive& m);
+    /// Explore current subproblem, return false if master is gone
+    bool explore(void);
+  public:
+    /// Initialize with root \a r, options \a o, best \a b, channel \a c
+    Worker(const Space& r, const Options& o, bool b, Channel& c);
+    /// Serve requests from master until it is gone
+    void run(void);
+    /// Destructor
+    ~Worker(void);
+  };
+
+  /**
+   * \brief Distributed engine controlling worker processes
+   *
+   * The engine keeps a pool of subproblems not yet explored,
+   * hands them out to idle workers, and asks busy workers to split
+   * off subproblems whenever the pool is empty and some workers are
+   * idle. Solutions are recomputed from their archived paths.
+   */
+  class Engine : public Search::Engine {
+  protected:
+    /// Search options
+    Options opt;
+    /// Whether best solution search is performed
+    bool bab;
+    /// Root space (NULL if failed)
+    Space* root;
+    /// Best solution found so far
+    Space* best;
+    /// Number of workers
+    unsigned int n_workers;
+    /// Channels to workers
+    Channel* chan;
+    /// Process identifiers of workers
+    pid_t* pid;
+    /// Statistics as last reported by workers
+    Search::Worker* stat;
+    /// Whether worker explores a subproblem
+    bool* busy;
+    /// Whether worker has been asked to split off a subproblem
+    bool* stealing;
+    /// Statistics for root
+    Statistics root_stat;
+    /// Subproblems to be explored
+    Support::DynamicQueue<Archive*,Heap> pool;
+    /// Solutions not yet returned
+    Support::DynamicQueue<Space*,Heap> solutions;
+    /// Whether engine has been stopped
+    bool _stopped;
+    /// Send message \a m to worker \a i
+    void send(unsigned int i, const Archive& m);
+    /// Handle solution from worker \a i in message \a m starting at \a p
+    void solution(unsigned int i, Archive& m, int p);
+    /// Handle message \a m from worker \a i
+    void handle(unsigned int i, Archive& m);
+    /// Hand out subproblems and ask for more if needed
+    void dispatch(void);
+    /// Wait for messages from workers and handle them
+    void receive(void);
+    /// Test whether search is finished
+    bool finished(void) const;
+  public:
+    /// Initialize for space \a s with options \a o and best search \a b
+    Engine(Space* s, const Options& o, bool b);
+    /// Return next solution (NULL, if none exists or search has been stopped)
+    virtual Space* next(void);
+    /// Return statistics
+    virtual Statistics statistics(void) const;
+    /// Check whether engine has been stopped
+    virtual bool stopped(void) const;
+    /// Destructor
+    virtual ~Engine(void);
+  };
+
+}}}
+
+#endif
+
+#endif
+
+// STATISTICS: search-distributed
@@ -0,0 +1,90 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode { namespace Search {
+
+  /// Create embarrassingly parallel engine (best solution search if \a best)
+  GECODE_SEARCH_EXPORT Engine*
+  eps(Space* s, const Options& o, bool best);
+
+  /// An EPS engine builder
+  template<class T, template<class> class E>
+  class EpsBuilder : public Builder {
+    using Builder::opt;
+  public:
+    /// The constructor
+    EpsBuilder(const Options& opt);
+    /// The actual build function
+    virtual Engine* operator() (Space* s) const;
+  };
+
+  template<class T, template<class> class E>
+  inline
+  EpsBuilder<T,E>::EpsBuilder(const Options& opt)
+    : Builder(opt,E<T>::best) {}
+
+  template<class T, template<class> class E>
+  Engine*
+  EpsBuilder<T,E>::operator() (Space* s) const {
+    return build<T,EPS<T,E> >(s,opt);
+  }
+
+}}
+
+namespace Gecode {
+
+  template<class T, template<class> class E>
+  inline
+  EPS<T,E>::EPS(T* s, const Search::Options& o)
+    : Search::Base<T>(Search::eps(s,o,E<T>::best)) {}
+
+  template<class T, template<class> class E>
+  inline T*
+  eps(T* s, const Search::Options& o) {
+    EPS<T,E> e(s,o);
+    return e.next();
+  }
+
+  template<class T, template<class> class E>
+  SEB
+  eps(const Search::Options& o) {
+    return new Search::EpsBuilder<T,E>(o);
+  }
+
+}
+
+// STATISTICS: search-other
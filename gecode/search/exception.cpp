@@ -52,6 +52,15 @@ namespace Gecode { namespace Search {
   NoBest::NoBest(const char* l)
     : Exception(l,"Best solution search is not supported") {}
 
+  NoCheckpoint::NoCheckpoint(const char* l)
+    : Exception(l,"Checkpointing is not supported") {}
+
+  IllegalCheckpoint::IllegalCheckpoint(const char* l)
+    : Exception(l,"Archive is not a checkpoint for this engine") {}
+
+  WorkerFailure::WorkerFailure(const char* l)
+    : Exception(l,"Worker process for distributed search failed") {}
+
 }}
 
 // STATISTICS: search-other
@@ -66,6 +66,24 @@ namespace Gecode { namespace Search {
     /// Initialize with location \a l
     NoBest(const char* l);
   };
+  /// %Exception: Checkpointing is not supported by search engine
+  class GECODE_SEARCH_EXPORT NoCheckpoint : public Exception {
+  public:
+    /// Initialize with location \a l
+    NoCheckpoint(const char* l);
+  };
+  /// %Exception: Archive is not a checkpoint of the search engine
+  class GECODE_SEARCH_EXPORT IllegalCheckpoint : public Exception {
+  public:
+    /// Initialize with location \a l
+    IllegalCheckpoint(const char* l);
+  };
+  /// %Exception: Worker process of distributed search failed
+  class GECODE_SEARCH_EXPORT WorkerFailure : public Exception {
+  public:
+    /// Initialize with location \a l
+    WorkerFailure(const char* l);
+  };
   //@}
 }}
 
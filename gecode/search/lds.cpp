@@ -40,13 +40,25 @@
 
 #include <gecode/search.hh>
 #include <gecode/search/sequential/lds.hh>
+#ifdef GECODE_HAS_THREADS
+#include <gecode/search/parallel/lds.hh>
+#endif
 #include <gecode/search/support.hh>
 
 namespace Gecode { namespace Search {
     
   Engine* 
   lds(Space* s, const Options& o) {
+#ifdef GECODE_HAS_THREADS
+    Options to = o.expand();
+    // Parallelism is limited by the number of discrepancies
+    if ((to.threads == 1.0) || (to.d_l == 0))
+      return new Sequential::LDS(s,to);
+    else
+      return new Parallel::LDS(s,to);
+#else
     return new Sequential::LDS(s,o);
+#endif
   }
 
 }}
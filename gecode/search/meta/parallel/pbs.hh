@@ -148,6 +148,8 @@ namespace Gecode { namespace Search { namespace Meta { namespace Parallel {
     Slave<Collect>** slaves;
     /// Number of slave engines
     unsigned int n_slaves;
+    /// Number of slave engines including those that have finished
+    unsigned int n_all;
     /// Whether a slave has been stopped
     bool slave_stop;
     /// Shared stop flag
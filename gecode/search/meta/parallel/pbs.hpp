@@ -155,7 +155,7 @@ namespace Gecode { namespace Search { namespace Meta { namespace Parallel {
   PBS<Collect>::PBS(Engine** engines, Stop** stops, unsigned int n,
                     const Statistics& stat0)
     : stat(stat0), slaves(heap.alloc<Slave<Collect>*>(n)), n_slaves(n),
-      slave_stop(false), tostop(false), n_busy(0) {
+      n_all(n), slave_stop(false), tostop(false), n_busy(0) {
     // Initialize slaves
     for (unsigned int i=n_slaves; i--; ) {
       slaves[i] = new Slave<Collect>(this,engines[i],stops[i]);
@@ -177,15 +177,19 @@ namespace Gecode { namespace Search { namespace Meta { namespace Parallel {
       if (!tostop)
         slave_stop = true;
     } else {
-      // Delete slave from slaves
+      // Move slave behind the active slaves
       stat += slave->statistics();
-      // Do not actually delete, the thread should do that upon termination
-      slave->todelete(true);
+      /*
+       * The slave is deleted by the destructor: the thread executing
+       * the slave must not access it after it has been run, as the
+       * engine might be deleted as soon as all slaves are idle.
+       */
       unsigned int i=0;
       while (slaves[i] != slave)
         i++;
       assert(i < n_slaves);
       slaves[i] = slaves[--n_slaves];
+      slaves[n_slaves] = slave;
     }
     if (b) {
       if (--n_busy == 0)
@@ -279,9 +283,8 @@ namespace Gecode { namespace Search { namespace Meta { namespace Parallel {
 
   template<class Collect>
   PBS<Collect>::~PBS(void) {
-    for (unsigned int i=n_slaves; i--; )
+    for (unsigned int i=n_all; i--; )
       delete slaves[i];
-    // Note that n_slaves might be different now!
     heap.rfree(slaves);
   }
 
@@ -44,6 +44,8 @@ namespace Gecode { namespace Search {
       c_d(Config::c_d), a_d(Config::a_d),
       d_l(Config::d_l),
       share_rbs(true), share_pbs(false),
+      afc_lockfree(Config::afc_lockfree),
+      deterministic(Config::deterministic),
       assets(0), slice(Config::slice), nogoods_limit(0),
       stop(NULL), cutoff(NULL) {}
 
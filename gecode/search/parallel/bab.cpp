@@ -56,6 +56,16 @@ namespace Gecode { namespace Search { namespace Parallel {
 
   void
   BAB::constrain(const Space& b) {
+#ifdef GECODE_HAS_ATOMICS
+    int o;
+    if (b.objective(o)) {
+      m_search.acquire();
+      if (o < bound)
+        Support::atomic_store(bound,o);
+      m_search.release();
+      return;
+    }
+#endif
     m_search.acquire();
     if (best != NULL) {
       best->constrain(b);
@@ -123,6 +133,7 @@ namespace Gecode { namespace Search { namespace Parallel {
         // Perform exploration work
         {
           m.acquire();
+          tighten();
           if (idle) {
             m.release();
             // Try to find new work
@@ -135,7 +146,9 @@ namespace Gecode { namespace Search { namespace Parallel {
               engine().stop();
             } else {
               node++;
-              switch (cur->status(*this)) {
+              bool r = recomputed;
+              recomputed = false;
+              switch (dist.status(*cur,r,*this)) {
               case SS_FAILED:
                 fail++;
                 delete cur;
@@ -158,8 +171,8 @@ namespace Gecode { namespace Search { namespace Parallel {
               case SS_BRANCH:
                 {
                   Space* c;
-                  if ((d == 0) || (d >= engine().opt().c_d)) {
-                    c = cur->clone();
+                  if ((d == 0) || (d >= dist.c_d())) {
+                    c = dist.clone(*cur);
                     d = 1;
                   } else {
                     c = NULL;
@@ -175,7 +188,11 @@ namespace Gecode { namespace Search { namespace Parallel {
               }
             }
           } else if (!path.empty()) {
-            cur = path.recompute(d,engine().opt().a_d,*this,*best,mark);
+            if (best != NULL)
+              cur = path.recompute(d,dist.a_d(),*this,*best,mark);
+            else
+              cur = path.recompute(d,dist.a_d(),*this,bound,mark);
+            recomputed = true;
             if (cur == NULL)
               path.next();
             m.release();
@@ -210,6 +227,7 @@ namespace Gecode { namespace Search { namespace Parallel {
     // All workers are marked as busy again
     delete best;
     best = NULL;
+    bound = INT_MAX;
     n_busy = workers();
     for (unsigned int i=1; i<workers(); i++)
       worker(i)->reset(NULL,0);
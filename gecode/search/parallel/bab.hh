@@ -40,6 +40,8 @@
 
 #include <gecode/search/parallel/engine.hh>
 
+#include <climits>
+
 namespace Gecode { namespace Search { namespace Parallel {
 
   /// %Parallel branch-and-bound engine
@@ -52,6 +54,8 @@ namespace Gecode { namespace Search { namespace Parallel {
       int mark;
       /// Best solution found so far
       Space* best;
+      /// Objective bound the entries above mark are constrained by
+      int bound;
     public:
       /// Initialize for space \a s with engine \a e
       Worker(Space* s, BAB& e);
@@ -61,6 +65,8 @@ namespace Gecode { namespace Search { namespace Parallel {
       virtual void run(void);
       /// Accept better solution \a b
       void better(Space* b);
+      /// Tighten by objective bound of engine if it is better
+      void tighten(void);
       /// Try to find some work
       void find(void);
       /// Reset engine to restart at space \a s
@@ -72,6 +78,14 @@ namespace Gecode { namespace Search { namespace Parallel {
     Worker** _worker;
     /// Best solution so far
     Space* best;
+    /**
+     * \brief Objective bound of best solution so far
+     *
+     * Used instead of \a best if spaces provide an objective value
+     * (INT_MAX if there is no best solution). The bound is read by
+     * workers without locking.
+     */
+    int bound;
   public:
     /// Provide access to worker \a i
     Worker* worker(unsigned int i) const;
@@ -119,6 +133,7 @@ namespace Gecode { namespace Search { namespace Parallel {
     delete cur;
     delete best;
     best = NULL;
+    bound = INT_MAX;
     path.reset((s == NULL) ? 0 : ngdl);
     d = 0;
     mark = 0;
@@ -138,11 +153,11 @@ namespace Gecode { namespace Search { namespace Parallel {
    */
   forceinline
   BAB::Worker::Worker(Space* s, BAB& e)
-    : Engine::Worker(s,e), mark(0), best(NULL) {}
+    : Engine::Worker(s,e), mark(0), best(NULL), bound(INT_MAX) {}
 
   forceinline
   BAB::BAB(Space* s, const Options& o)
-    : Engine(o), best(NULL) {
+    : Engine(o), best(NULL), bound(INT_MAX) {
     // Create workers
     _worker = static_cast<Worker**>
       (heap.ralloc(workers() * sizeof(Worker*)));
@@ -173,7 +188,41 @@ namespace Gecode { namespace Search { namespace Parallel {
     m.release();
   }
   forceinline void
+  BAB::Worker::tighten(void) {
+    int b = Support::atomic_load(engine().bound);
+    if (b < bound) {
+      bound = b;
+      mark = path.entries();
+      if (cur != NULL)
+        cur->improve(b);
+    }
+  }
+  forceinline void
   BAB::solution(Space* s) {
+#ifdef GECODE_HAS_ATOMICS
+    int o;
+    if (s->objective(o)) {
+      // As the bound only decreases, worse solutions can be rejected early
+      if (o >= Support::atomic_load(bound)) {
+        delete s;
+        return;
+      }
+      m_search.acquire();
+      if (o >= bound) {
+        delete s;
+        m_search.release();
+        return;
+      }
+      // Workers pick up the new bound themselves
+      Support::atomic_store(bound,o);
+      bool bs = signal();
+      solutions.push(s);
+      if (bs)
+        e_search.signal();
+      m_search.release();
+      return;
+    }
+#endif
     m_search.acquire();
     if (best != NULL) {
       s->constrain(*best);
@@ -205,9 +254,13 @@ namespace Gecode { namespace Search { namespace Parallel {
   forceinline void
   BAB::Worker::find(void) {
     // Try to find new work (even if there is none)
-    for (unsigned int i=0; i<engine().workers(); i++) {
+    unsigned int n = engine().workers();
+    for (unsigned int i=0, v=victim(n); i<n; i++, v=(v+1 < n) ? v+1 : 0) {
+      Worker* w = engine().worker(v);
+      if (w == this)
+        continue;
       unsigned long int r_d = 0ul;
-      if (Space* s = engine().worker(i)->steal(r_d)) {
+      if (Space* s = w->steal(r_d)) {
         // Reset this guy
         m.acquire();
         idle = false;
@@ -215,14 +268,21 @@ namespace Gecode { namespace Search { namespace Parallel {
         path.ngdl(0);
         d = 0;
         cur = s;
+        recomputed = true;
         mark = 0;
         if (best != NULL)
           cur->constrain(*best);
+        bound = Support::atomic_load(engine().bound);
+        if (bound < INT_MAX)
+          cur->improve(bound);
         Search::Worker::reset(r_d);
         m.release();
+        stolen();
         return;
       }
     }
+    // No work found, back off before trying again
+    starve();
   }
 
 }}}
@@ -113,7 +113,9 @@ namespace Gecode { namespace Search { namespace Parallel {
               engine().stop();
             } else {
               node++;
-              switch (cur->status(*this)) {
+              bool r = recomputed;
+              recomputed = false;
+              switch (dist.status(*cur,r,*this)) {
               case SS_FAILED:
                 fail++;
                 delete cur;
@@ -136,8 +138,8 @@ namespace Gecode { namespace Search { namespace Parallel {
               case SS_BRANCH:
                 {
                   Space* c;
-                  if ((d == 0) || (d >= engine().opt().c_d)) {
-                    c = cur->clone();
+                  if ((d == 0) || (d >= dist.c_d())) {
+                    c = dist.clone(*cur);
                     d = 1;
                   } else {
                     c = NULL;
@@ -153,7 +155,8 @@ namespace Gecode { namespace Search { namespace Parallel {
               }
             }
           } else if (!path.empty()) {
-            cur = path.recompute(d,engine().opt().a_d,*this);
+            cur = path.recompute(d,dist.a_d(),*this);
+            recomputed = true;
             if (cur == NULL)
               path.next();
             m.release();
@@ -164,9 +164,13 @@ namespace Gecode { namespace Search { namespace Parallel {
   forceinline void
   DFS::Worker::find(void) {
     // Try to find new work (even if there is none)
-    for (unsigned int i=0; i<engine().workers(); i++) {
+    unsigned int n = engine().workers();
+    for (unsigned int i=0, v=victim(n); i<n; i++, v=(v+1 < n) ? v+1 : 0) {
+      Worker* w = engine().worker(v);
+      if (w == this)
+        continue;
       unsigned long int r_d = 0ul;
-      if (Space* s = engine().worker(i)->steal(r_d)) {
+      if (Space* s = w->steal(r_d)) {
         // Reset this guy
         m.acquire();
         idle = false;
@@ -174,11 +178,15 @@ namespace Gecode { namespace Search { namespace Parallel {
         path.ngdl(0);
         d = 0;
         cur = s;
+        recomputed = true;
         Search::Worker::reset(r_d);
         m.release();
+        stolen();
         return;
       }
     }
+    // No work found, back off before trying again
+    starve();
   }
 
 }}}
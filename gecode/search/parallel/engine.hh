@@ -41,6 +41,7 @@
 #include <gecode/search.hh>
 #include <gecode/search/support.hh>
 #include <gecode/search/worker.hh>
+#include <gecode/search/distance.hh>
 #include <gecode/search/parallel/path.hh>
 
 namespace Gecode { namespace Search { namespace Parallel {
@@ -61,8 +62,22 @@ namespace Gecode { namespace Search { namespace Parallel {
       Space* cur;
       /// Distance until next clone
       unsigned int d;
+      /// Commit and adaptive distance
+      Distance dist;
+      /// Whether the current space has been recomputed or stolen
+      bool recomputed;
       /// Whether the worker is idle
       bool idle;
+      /// Random number generator for selecting victims
+      Support::RandomGenerator rnd;
+      /// Current number of spin iterations for backing off
+      unsigned int backoff;
+      /// Return first victim to try for stealing among \a n workers
+      unsigned int victim(unsigned int n);
+      /// Record that stealing succeeded
+      void stolen(void);
+      /// Back off as stealing failed
+      void starve(void);
     public:
       /// Initialize for space \a s with engine \a e
       Worker(Space* s, Engine& e);
@@ -246,8 +261,13 @@ namespace Gecode { namespace Search { namespace Parallel {
   Engine::Worker::Worker(Space* s, Engine& e)
     : _engine(e),
       path(s == NULL ? 0 : e.opt().nogoods_limit), d(0),
-      idle(false) {
+      dist(e.opt()), recomputed(false), idle(false),
+      rnd(static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(this))),
+      backoff(Config::steal_backoff_min) {
     if (s != NULL) {
+      // All workers share the AFC information of s
+      if (e.opt().afc_lockfree)
+        s->afc_lockfree(true);
       if (s->status(*this) == SS_FAILED) {
         fail++;
         cur = NULL;
@@ -282,6 +302,7 @@ namespace Gecode { namespace Search { namespace Parallel {
   Engine::Worker::statistics(void) {
     m.acquire();
     Statistics s = *this;
+    dist.statistics(s);
     m.release();
     return s;
   }
@@ -397,6 +418,35 @@ namespace Gecode { namespace Search { namespace Parallel {
   /*
    * Worker: finding and stealing working
    */
+  forceinline unsigned int
+  Engine::Worker::victim(unsigned int n) {
+    /*
+     * Start at a random worker such that idle workers do not all
+     * line up on the same victim's mutex.
+     */
+    return rnd(n);
+  }
+
+  forceinline void
+  Engine::Worker::stolen(void) {
+    backoff = Config::steal_backoff_min;
+  }
+
+  forceinline void
+  Engine::Worker::starve(void) {
+    /*
+     * Exponential backoff: spin for a while first (work typically
+     * becomes available soon), and give up the processor only after
+     * repeated failures.
+     */
+    if (backoff < Config::steal_backoff_max) {
+      for (volatile unsigned int i=backoff; i>0; i--) {}
+      backoff <<= 1;
+    } else {
+      Support::Thread::sleep(1);
+    }
+  }
+
   forceinline Space*
   Engine::Worker::steal(unsigned long int& d) {
     /*
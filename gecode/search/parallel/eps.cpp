@@ -0,0 +1,552 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/support.hh>
+
+#ifdef GECODE_HAS_THREADS
+
+#include <gecode/search/parallel/eps.hh>
+#include <gecode/search/sequential/dfs.hh>
+#include <gecode/search/sequential/bab.hh>
+
+namespace Gecode { namespace Search { namespace Parallel {
+
+  /*
+   * Stop object
+   *
+   */
+  bool
+  EPSStop::stop(const Statistics& s, const Options& o) {
+    if (*tostop)
+      return true;
+    if (so == NULL)
+      return false;
+    Statistics t(*done);
+    t += s;
+    if (so->stop(t,o)) {
+      _user = true;
+      return true;
+    }
+    return false;
+  }
+
+
+  /*
+   * Workers
+   *
+   */
+  EPS::Worker::Worker(EPS& e0)
+    : Support::Runnable(false), eps(e0),
+      _stop(e0.options().stop,&e0.tostop,&done), e(NULL), active(false),
+      index(0), found(heap) {}
+
+  void
+  EPS::Worker::start(Space* s, unsigned int i) {
+    if (e == NULL) {
+      Options o(eps.options());
+      o.threads = 1;
+      o.clone = false;
+      o.stop = &_stop;
+      if (eps.best_search())
+        e = new WorkerToEngine<Sequential::BAB>(s,o);
+      else
+        e = new WorkerToEngine<Sequential::DFS>(s,o);
+    } else {
+      done += e->statistics();
+      e->reset(s);
+    }
+    index = i;
+    active = true;
+  }
+
+  Statistics
+  EPS::Worker::statistics(void) const {
+    Statistics s(done);
+    if (e != NULL)
+      s += e->statistics();
+    return s;
+  }
+
+  Statistics
+  EPS::Worker::explored(void) const {
+    return done;
+  }
+
+  void
+  EPS::Worker::constrain(const Space& b) {
+    if (active)
+      e->constrain(b);
+  }
+
+  void
+  EPS::Worker::reset(void) {
+    delete e;
+    e = NULL;
+    done.reset();
+    active = false;
+    index = 0;
+    while (!found.empty())
+      delete found.pop();
+  }
+
+  void
+  EPS::Worker::step(void) {
+    Space* s;
+    while ((s = e->next()) != NULL) {
+      // The solution is passed to another thread and must not share
+      Space* c = s->clone(false);
+      delete s;
+      if (eps.best_search()) {
+        // Only the best solution for the subproblem is kept
+        while (!found.empty())
+          delete found.pop();
+        found.push(c);
+      } else {
+        found.push(c);
+        break;
+      }
+    }
+    if ((s == NULL) && !e->stopped())
+      active = false;
+    eps.progress(this);
+  }
+
+  void
+  EPS::Worker::run(void) {
+    if (eps.deterministic()) {
+      step();
+      return;
+    }
+    while (true) {
+      if (!active) {
+        Space* s = eps.subproblem();
+        if (s == NULL) {
+          eps.finish(false);
+          return;
+        }
+        start(s,0);
+      }
+      Space* s = e->next();
+      if (s != NULL) {
+        // The solution is passed to another thread and must not share
+        Space* c = s->clone(false);
+        delete s;
+        s = c;
+        // The engine might be deleted as soon as the report is done
+        if (eps.report(this,s))
+          return;
+      } else if (e->stopped()) {
+        eps.finish(true);
+        return;
+      } else {
+        active = false;
+      }
+    }
+  }
+
+  EPS::Worker::~Worker(void) {
+    while (!found.empty())
+      delete found.pop();
+    delete e;
+  }
+
+
+  /*
+   * Engine
+   *
+   */
+  /// Perform the \a n commits archived in \a a on space \a s
+  static void
+  replay(Space* s, unsigned int n, const Archive& a) {
+    Archive c(a);
+    for (unsigned int i=0; i<n; i++) {
+      unsigned int alt; c >> alt;
+      const Choice* ch = s->choice(c);
+      s->commit(*ch,alt);
+      delete ch;
+    }
+  }
+
+  bool
+  EPS::solution(Space* s, Worker* w) {
+    if (bab) {
+      if (best != NULL) {
+        // Check whether s is in fact better than best
+        best->constrain(*s);
+        if (best->status() != SS_FAILED) {
+          delete s;
+          return false;
+        }
+        delete best;
+      }
+      best = s->clone(false);
+      reporter = w;
+    }
+    solutions.push(s);
+    return true;
+  }
+
+  void
+  EPS::decompose(void) {
+    unsigned int target = Config::eps_subproblems * n_workers;
+    depth = 0;
+    n_sub = 0;
+    first = 0;
+    if (root->status(stat) == SS_SOLVED) {
+      Space* s = root->clone(false);
+      (void) s->choice();
+      (void) solution(s,NULL);
+      return;
+    }
+    // Expand all subproblems of the same depth until there are enough
+    subproblems.push(new Archive);
+    unsigned int n = 1;
+    while ((n > 0) && (n < target)) {
+      Support::DynamicQueue<Archive*,Heap> children(heap);
+      n = 0;
+      while (!subproblems.empty()) {
+        Archive* a = subproblems.pop();
+        Space* s = root->clone(false);
+        replay(s,depth,*a);
+        if (s->status(stat) != SS_BRANCH) {
+          // Only possible for weakly monotonic propagators
+          delete s; delete a;
+          continue;
+        }
+        const Choice* ch = s->choice();
+        for (unsigned int alt=0; alt<ch->alternatives(); alt++) {
+          Space* c = (alt+1 < ch->alternatives()) ? s->clone(false) : s;
+          c->commit(*ch,alt);
+          stat.node++;
+          switch (c->status(stat)) {
+          case SS_FAILED:
+            stat.fail++;
+            delete c;
+            break;
+          case SS_SOLVED:
+            // Deletes all pending branchers
+            (void) c->choice();
+            (void) solution(c,NULL);
+            break;
+          case SS_BRANCH:
+            {
+              Archive* b = new Archive(*a);
+              *b << alt;
+              ch->archive(*b);
+              children.push(b);
+              n++;
+              delete c;
+            }
+            break;
+          default:
+            GECODE_NEVER;
+          }
+        }
+        delete ch;
+        delete a;
+      }
+      while (!children.empty())
+        subproblems.push(children.pop());
+      depth++;
+      stat.depth = std::max(stat.depth,static_cast<unsigned long int>(depth));
+    }
+    n_sub = n;
+    if (det && !bab)
+      for (unsigned int i=0; (i<n_workers) && (i<n_sub); i++)
+        workers[i]->start(subproblem(),i);
+  }
+
+  Space*
+  EPS::subproblem(void) {
+    m.acquire();
+    if (subproblems.empty()) {
+      m.release();
+      return NULL;
+    }
+    Archive* a = subproblems.pop();
+    // Cloning the root and constraining must be done exclusively
+    Space* s = root->clone(false);
+    if (best != NULL)
+      s->constrain(*best);
+    m.release();
+    replay(s,depth,*a);
+    delete a;
+    return s;
+  }
+
+  bool
+  EPS::report(Worker* w, Space* s) {
+    m.acquire();
+    if (!solution(s,w)) {
+      m.release();
+      return false;
+    }
+    tostop = true;
+    if (--n_busy == 0)
+      idle.signal();
+    m.release();
+    return true;
+  }
+
+  void
+  EPS::progress(Worker* w) {
+    m.acquire();
+    // For depth-first search, the first subproblem decides
+    if ((!bab && (w->index == first)) || w->stop().user())
+      tostop = true;
+    if (--n_busy == 0)
+      idle.signal();
+    m.release();
+  }
+
+  void
+  EPS::finish(bool s) {
+    m.acquire();
+    if (s && !tostop)
+      w_stop = true;
+    if (--n_busy == 0)
+      idle.signal();
+    m.release();
+  }
+
+  EPS::EPS(Space* s, const Options& o, bool b)
+    : opt(o), bab(b), det(o.deterministic), root(NULL), depth(0),
+      n_sub(0), first(0),
+      subproblems(heap), solutions(heap), best(NULL), reporter(NULL),
+      n_workers(static_cast<unsigned int>(o.threads)),
+      w_stop(false), tostop(false), n_busy(0) {
+    workers = heap.alloc<Worker*>(n_workers);
+    for (unsigned int i=0; i<n_workers; i++)
+      workers[i] = new Worker(*this);
+    if ((s == NULL) || (s->status(stat) == SS_FAILED)) {
+      stat.fail++;
+      if (!opt.clone)
+        delete s;
+    } else {
+      root = snapshot(s,opt);
+      decompose();
+    }
+  }
+
+  void
+  EPS::explore(void) {
+    tostop = false;
+    n_busy = 0;
+    for (unsigned int i=0; i<n_workers; i++) {
+      workers[i]->stop().reset();
+      if (workers[i]->runnable())
+        n_busy++;
+    }
+    if (n_busy == 0)
+      return;
+    // Counting down starts as soon as the first worker runs
+    unsigned int n = n_busy;
+    for (unsigned int i=0, j=0; j<n; i++)
+      if (workers[i]->runnable()) {
+        j++;
+        Support::Thread::run(workers[i]);
+      }
+    idle.wait();
+    // Wait until the last worker has released the mutex
+    m.acquire();
+    m.release();
+  }
+
+  Space*
+  EPS::next_dfs(void) {
+    while (true) {
+      if (!solutions.empty())
+        return solutions.pop();
+      if (first >= n_sub)
+        return NULL;
+      Worker* w = workers[first % n_workers];
+      if (!w->found.empty())
+        return w->found.pop();
+      if (!w->active) {
+        // The worker continues with the next subproblem it is due for
+        if (first + n_workers < n_sub)
+          w->start(subproblem(),first + n_workers);
+        first++;
+        continue;
+      }
+      explore();
+      if (w->active && w->found.empty()) {
+        // The first subproblem can only be stopped by a stop object
+        w_stop = true;
+        return NULL;
+      }
+    }
+  }
+
+  Space*
+  EPS::next_bab(void) {
+    while (true) {
+      if (!solutions.empty())
+        return solutions.pop();
+      bool running = false;
+      for (unsigned int i=0; i<n_workers; i++)
+        running |= workers[i]->active;
+      if (!running) {
+        // Start the next round
+        if (subproblems.empty())
+          return NULL;
+        for (unsigned int i=0; (i<n_workers) && !subproblems.empty(); i++)
+          workers[i]->start(subproblem(),first++);
+      }
+      explore();
+      for (unsigned int i=0; i<n_workers; i++)
+        if (workers[i]->active) {
+          w_stop = true;
+          return NULL;
+        }
+      // Merge the best solutions of the round in order
+      for (unsigned int i=0; i<n_workers; i++)
+        while (!workers[i]->found.empty())
+          (void) solution(workers[i]->found.pop(),NULL);
+    }
+  }
+
+  Space*
+  EPS::next(void) {
+    if (det && (root != NULL)) {
+      w_stop = false;
+      return bab ? next_bab() : next_dfs();
+    }
+    m.acquire();
+    if (solutions.empty() && (root != NULL)) {
+      tostop = false;
+      w_stop = false;
+      // Invariant: all workers are idle
+      assert(n_busy == 0);
+      n_busy = n_workers;
+      for (unsigned int i=0; i<n_workers; i++)
+        Support::Thread::run(workers[i]);
+      m.release();
+      // Wait for all workers to become idle
+      idle.wait();
+      m.acquire();
+    }
+    Space* s = NULL;
+    if (!solutions.empty()) {
+      s = solutions.pop();
+      if (reporter != NULL) {
+        // Announce best solution to all other workers
+        for (unsigned int i=0; i<n_workers; i++)
+          if (workers[i] != reporter)
+            workers[i]->constrain(*best);
+        reporter = NULL;
+      }
+    }
+    m.release();
+    return s;
+  }
+
+  Statistics
+  EPS::statistics(void) const {
+    Statistics s(stat);
+    for (unsigned int i=0; i<n_workers; i++)
+      if (det && !bab && (workers[i]->index > first))
+        // Exploration ahead of the first subproblem is speculative
+        s += workers[i]->explored();
+      else
+        s += workers[i]->statistics();
+    return s;
+  }
+
+  bool
+  EPS::stopped(void) const {
+    return w_stop;
+  }
+
+  void
+  EPS::constrain(const Space& b) {
+    if (!bab)
+      throw NoBest("EPS::constrain");
+    if (best != NULL) {
+      best->constrain(b);
+      if (best->status() != SS_FAILED)
+        return;
+      delete best;
+    }
+    best = b.clone(false);
+    reporter = NULL;
+    // Deterministic search only uses the best solution for new rounds
+    if (!det)
+      for (unsigned int i=0; i<n_workers; i++)
+        workers[i]->constrain(b);
+  }
+
+  void
+  EPS::reset(Space* s) {
+    delete root;
+    root = NULL;
+    delete best;
+    best = NULL;
+    reporter = NULL;
+    while (!subproblems.empty())
+      delete subproblems.pop();
+    while (!solutions.empty())
+      delete solutions.pop();
+    for (unsigned int i=0; i<n_workers; i++)
+      workers[i]->reset();
+    stat.reset();
+    if ((s == NULL) || (s->status(stat) == SS_FAILED)) {
+      stat.fail++;
+      delete s;
+    } else {
+      root = s;
+      decompose();
+    }
+  }
+
+  EPS::~EPS(void) {
+    for (unsigned int i=0; i<n_workers; i++)
+      delete workers[i];
+    heap.free<Worker*>(workers,n_workers);
+    while (!subproblems.empty())
+      delete subproblems.pop();
+    while (!solutions.empty())
+      delete solutions.pop();
+    delete best;
+    delete root;
+  }
+
+}}}
+
+#endif
+
+// STATISTICS: search-parallel
@@ -0,0 +1,265 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_SEARCH_PARALLEL_EPS_HH__
+#define __GECODE_SEARCH_PARALLEL_EPS_HH__
+
+#include <gecode/search.hh>
+#include <gecode/search/support.hh>
+
+namespace Gecode { namespace Search { namespace Parallel {
+
+  /// Stop object for workers of embarrassingly parallel search
+  class EPSStop : public Stop {
+  protected:
+    /// The stop object for the engine
+    Stop* so;
+    /// Whether workers must stop
+    volatile bool* tostop;
+    /// Statistics for subproblems already explored by the worker
+    const Statistics* done;
+    /// Whether the stop object for the engine has stopped the worker
+    bool _user;
+  public:
+    /// Initialize with stop object \a so, flag \a ts, and statistics \a d
+    EPSStop(Stop* so, volatile bool* ts, const Statistics* d);
+    /// Return true if worker must be stopped
+    virtual bool stop(const Statistics& s, const Options& o);
+    /// Whether the stop object for the engine has stopped the worker
+    bool user(void) const;
+    /// Forget whether the worker has been stopped
+    void reset(void);
+  };
+
+  /**
+   * \brief Embarrassingly parallel search engine
+   *
+   * The root space is decomposed by a breadth-first exploration into
+   * at least Config::eps_subproblems subproblems per worker, where
+   * only subproblems that survive propagation are kept. A subproblem
+   * is described by the commits leading to it from the root. The
+   * workers take subproblems from a shared queue and explore them by
+   * sequential depth-first or branch-and-bound search.
+   *
+   * If Options::deterministic is true, the work distribution only
+   * depends on the search tree and the number of workers:
+   *  - For depth-first search, worker \f$i\f$ explores the
+   *    subproblems \f$i\f$, \f$i+n\f$, \f$i+2n\f$, and so on
+   *    for \f$n\f$ workers. Solutions are returned in the order of
+   *    the subproblems and a worker that runs ahead keeps at most one
+   *    solution before it waits.
+   *  - For branch-and-bound search, the subproblems are explored in
+   *    rounds of \f$n\f$ subproblems. All subproblems of a round are
+   *    constrained by the best solution of the previous rounds, and
+   *    the best solutions of a round are merged in the order of the
+   *    subproblems.
+   *
+   * Statistics do not account for speculative exploration ahead of
+   * the first unfinished subproblem, so runs that are not stopped
+   * return the same solutions and statistics.
+   */
+  class EPS : public Search::Engine {
+  protected:
+    /// %Worker exploring subproblems
+    class Worker : public Support::Runnable {
+    protected:
+      /// The engine
+      EPS& eps;
+      /// Statistics for subproblems already explored
+      Statistics done;
+      /// Stop object
+      EPSStop _stop;
+      /// Sequential engine exploring the current subproblem
+      Search::Engine* e;
+    public:
+      /// Whether the current subproblem has not yet been explored
+      bool active;
+      /// Index of the current subproblem (deterministic mode)
+      unsigned int index;
+      /// Solutions found but not yet returned (deterministic mode)
+      Support::DynamicQueue<Space*,Heap> found;
+      /// Initialize for engine \a e
+      Worker(EPS& e);
+      /// Start exploring subproblem \a s with index \a i
+      void start(Space* s, unsigned int i);
+      /// Whether the worker has work in deterministic mode
+      bool runnable(void) const;
+      /// Return statistics
+      Statistics statistics(void) const;
+      /// Return statistics for subproblems already explored
+      Statistics explored(void) const;
+      /// Return stop object
+      EPSStop& stop(void);
+      /// Constrain current subproblem by better solution \a b
+      void constrain(const Space& b);
+      /// Forget the current subproblem
+      void reset(void);
+      /// Explore the current subproblem in deterministic mode
+      void step(void);
+      /// Explore subproblems until a solution is found or none is left
+      virtual void run(void);
+      /// Delete worker
+      virtual ~Worker(void);
+    };
+    /// Search options
+    Options opt;
+    /// Whether best solution search is performed
+    bool bab;
+    /// Whether search is deterministic
+    bool det;
+    /// Root space (NULL if failed)
+    Space* root;
+    /// Number of commits leading to each subproblem
+    unsigned int depth;
+    /// Number of subproblems after decomposition
+    unsigned int n_sub;
+    /// Index of first subproblem not yet finished (deterministic mode)
+    unsigned int first;
+    /// Subproblems not yet explored
+    Support::DynamicQueue<Archive*,Heap> subproblems;
+    /// Solutions not yet returned
+    Support::DynamicQueue<Space*,Heap> solutions;
+    /// Best solution found so far
+    Space* best;
+    /// Worker that has found the best solution (NULL if already announced)
+    Worker* reporter;
+    /// Statistics for the decomposition
+    Statistics stat;
+    /// Workers
+    Worker** workers;
+    /// Number of workers
+    unsigned int n_workers;
+    /// Whether a worker has been stopped
+    bool w_stop;
+    /// Shared stop flag
+    volatile bool tostop;
+    /// Mutex for synchronization
+    Support::Mutex m;
+    /// Number of busy workers
+    unsigned int n_busy;
+    /// Signal that number of busy workers becomes zero
+    Support::Event idle;
+    /// Report solution \a s (if better), return false if it is ignored
+    bool solution(Space* s, Worker* w);
+    /// Decompose root space into subproblems
+    void decompose(void);
+    /// Run all workers that have work and wait until they are idle
+    void explore(void);
+    /// Return next solution for deterministic depth-first search
+    Space* next_dfs(void);
+    /// Return next solution for deterministic branch-and-bound search
+    Space* next_bab(void);
+  public:
+    /// \name Interface for workers
+    //@{
+    /// Return next subproblem (NULL if there is none)
+    Space* subproblem(void);
+    /// Report solution \a s by worker \a w, return false if ignored
+    bool report(Worker* w, Space* s);
+    /// Report that a worker is finished (stopped if \a s)
+    void finish(bool s);
+    /// Report that worker \a w is idle (deterministic mode)
+    void progress(Worker* w);
+    /// Return options
+    const Options& options(void) const;
+    /// Whether best solution search is performed
+    bool best_search(void) const;
+    /// Whether search is deterministic
+    bool deterministic(void) const;
+    //@}
+    /// \name Engine interface
+    //@{
+    /// Initialize for space \a s with options \a o and best search \a b
+    EPS(Space* s, const Options& o, bool b);
+    /// Return next solution (NULL, if none exists or search has been stopped)
+    virtual Space* next(void);
+    /// Return statistics
+    virtual Statistics statistics(void) const;
+    /// Check whether engine has been stopped
+    virtual bool stopped(void) const;
+    /// Constrain future solutions to be better than \a b
+    virtual void constrain(const Space& b);
+    /// Reset engine to restart at space \a s
+    virtual void reset(Space* s);
+    /// Destructor
+    virtual ~EPS(void);
+    //@}
+  };
+
+
+  forceinline
+  EPSStop::EPSStop(Stop* so0, volatile bool* ts, const Statistics* d)
+    : so(so0), tostop(ts), done(d), _user(false) {}
+
+  forceinline bool
+  EPSStop::user(void) const {
+    return _user;
+  }
+
+  forceinline void
+  EPSStop::reset(void) {
+    _user = false;
+  }
+
+  forceinline EPSStop&
+  EPS::Worker::stop(void) {
+    return _stop;
+  }
+
+  forceinline bool
+  EPS::Worker::runnable(void) const {
+    return active && (eps.best_search() || found.empty());
+  }
+
+  forceinline const Options&
+  EPS::options(void) const {
+    return opt;
+  }
+  forceinline bool
+  EPS::best_search(void) const {
+    return bab;
+  }
+  forceinline bool
+  EPS::deterministic(void) const {
+    return det;
+  }
+
+}}}
+
+#endif
+
+// STATISTICS: search-parallel
@@ -0,0 +1,246 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/support.hh>
+
+#ifdef GECODE_HAS_THREADS
+
+#include <gecode/search/parallel/lds.hh>
+
+namespace Gecode { namespace Search { namespace Parallel {
+
+  /*
+   * Stop object
+   *
+   */
+  bool
+  LDSStop::stop(const Statistics& s, const Options& o) {
+    if (*tostop)
+      return true;
+    if ((so != NULL) && so->stop(s,o)) {
+      _user = true;
+      return true;
+    }
+    return false;
+  }
+
+
+  /*
+   * Workers
+   *
+   */
+  LDS::Worker::Worker(LDS& l)
+    : Support::Runnable(false), lds(l),
+      _stop(l.options().stop,&l.tostop), opt(l.options()),
+      d(0), active(false), solutions(heap) {
+    opt.stop = &_stop;
+    e.init(NULL);
+  }
+
+  void
+  LDS::Worker::start(Space* s, unsigned int d0) {
+    done += e.statistics();
+    e.reset(s,d0);
+    d = d0;
+    active = true;
+  }
+
+  void
+  LDS::Worker::reset(void) {
+    e.reset(NULL,0);
+    done.reset();
+    while (!solutions.empty())
+      delete solutions.pop();
+    active = false;
+  }
+
+  Statistics
+  LDS::Worker::statistics(void) const {
+    Statistics s(done);
+    s += e.statistics();
+    return s;
+  }
+
+  void
+  LDS::Worker::run(void) {
+    Space* s = e.next(opt);
+    if (s != NULL) {
+      // The solution is passed to another thread and must not share
+      Space* c = s->clone(false);
+      delete s;
+      s = c;
+    }
+    lds.report(this,s);
+  }
+
+  LDS::Worker::~Worker(void) {
+    while (!solutions.empty())
+      delete solutions.pop();
+  }
+
+
+  /*
+   * Engine
+   *
+   */
+  void
+  LDS::report(Worker* w, Space* s) {
+    m.acquire();
+    if (s != NULL)
+      w->solutions.push(s);
+    else if (!w->e.stopped())
+      w->active = false;
+    // Everybody stops if the smallest discrepancy has made progress
+    if ((w->d == d) || w->stop().user())
+      tostop = true;
+    if (--n_busy == 0)
+      idle.signal();
+    m.release();
+  }
+
+  void
+  LDS::start(Space* s) {
+    root = s;
+    d = 0;
+    for (unsigned int i=0; i<n_workers; i++)
+      workers[i]->start(root->clone(false),i);
+  }
+
+  LDS::LDS(Space* s, const Options& o)
+    : opt(o), root(NULL), d(0),
+      n_workers((o.d_l < o.threads) ? o.d_l+1
+                : static_cast<unsigned int>(o.threads)),
+      w_stop(false), tostop(false), n_busy(0) {
+    workers = heap.alloc<Worker*>(n_workers);
+    for (unsigned int i=0; i<n_workers; i++)
+      workers[i] = new Worker(*this);
+    stat.node = 1;
+    if (s->status(stat) == SS_FAILED) {
+      stat.fail++;
+      if (!opt.clone)
+        delete s;
+    } else {
+      start(snapshot(s,opt));
+    }
+  }
+
+  Space*
+  LDS::next(void) {
+    w_stop = false;
+    while (root != NULL) {
+      Worker* w = workers[d % n_workers];
+      if (!w->solutions.empty())
+        return w->solutions.pop();
+      if (!w->active) {
+        // All solutions with d discrepancies have been returned
+        if (w->e.done() || (d >= opt.d_l))
+          return NULL;
+        // The worker continues with the next discrepancy it is due for
+        if (d + n_workers <= opt.d_l)
+          w->start(root->clone(false),d + n_workers);
+        d++;
+        continue;
+      }
+      // Run probes until the smallest discrepancy makes progress
+      tostop = false;
+      n_busy = 0;
+      for (unsigned int i=0; i<n_workers; i++) {
+        workers[i]->stop().reset();
+        if (workers[i]->active && workers[i]->solutions.empty())
+          n_busy++;
+      }
+      // Snapshot busy workers as counting down starts immediately
+      unsigned int n = n_busy;
+      for (unsigned int i=0, j=0; j<n; i++)
+        if (workers[i]->active && workers[i]->solutions.empty()) {
+          j++;
+          Support::Thread::run(workers[i]);
+        }
+      idle.wait();
+      // Wait until the last worker has released the mutex
+      m.acquire();
+      m.release();
+      if (w->active && w->solutions.empty()) {
+        // The smallest discrepancy can only be stopped by a stop object
+        w_stop = true;
+        return NULL;
+      }
+    }
+    return NULL;
+  }
+
+  Statistics
+  LDS::statistics(void) const {
+    Statistics s(stat);
+    for (unsigned int i=0; i<n_workers; i++)
+      s += workers[i]->statistics();
+    return s;
+  }
+
+  bool
+  LDS::stopped(void) const {
+    return w_stop;
+  }
+
+  void
+  LDS::reset(Space* s) {
+    for (unsigned int i=0; i<n_workers; i++)
+      workers[i]->reset();
+    delete root;
+    root = NULL;
+    stat.reset();
+    stat.node = 1;
+    if ((s == NULL) || (s->status(stat) == SS_FAILED)) {
+      stat.fail++;
+      delete s;
+    } else {
+      start(s);
+    }
+  }
+
+  LDS::~LDS(void) {
+    for (unsigned int i=0; i<n_workers; i++)
+      delete workers[i];
+    heap.free<Worker*>(workers,n_workers);
+    delete root;
+  }
+
+}}}
+
+#endif
+
+// STATISTICS: search-parallel
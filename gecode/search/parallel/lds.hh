@@ -0,0 +1,193 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_SEARCH_PARALLEL_LDS_HH__
+#define __GECODE_SEARCH_PARALLEL_LDS_HH__
+
+#include <gecode/search.hh>
+#include <gecode/search/support.hh>
+#include <gecode/search/sequential/lds.hh>
+
+namespace Gecode { namespace Search { namespace Parallel {
+
+  /// Stop object for workers of parallel limited discrepancy search
+  class LDSStop : public Stop {
+  protected:
+    /// The stop object for the engine
+    Stop* so;
+    /// Whether workers must stop
+    volatile bool* tostop;
+    /// Whether the stop object for the engine has stopped the worker
+    bool _user;
+  public:
+    /// Initialize with stop object \a so and flag \a ts
+    LDSStop(Stop* so, volatile bool* ts);
+    /// Return true if worker must be stopped
+    virtual bool stop(const Statistics& s, const Options& o);
+    /// Whether the stop object for the engine has stopped the worker
+    bool user(void) const;
+    /// Forget whether the worker has been stopped
+    void reset(void);
+  };
+
+  /**
+   * \brief %Parallel limited discrepancy search engine
+   *
+   * The probes for different discrepancies are run concurrently: with
+   * \f$n\f$ workers, worker \f$i\f$ runs the probes for the
+   * discrepancies \f$i\f$, \f$i+n\f$, \f$i+2n\f$, and so on. Solutions
+   * are returned in the same order as by sequential %LDS: all
+   * solutions for a discrepancy are returned before the solutions
+   * for the next larger discrepancy. A worker that runs ahead keeps
+   * at most one solution before it waits.
+   */
+  class LDS : public Search::Engine {
+  protected:
+    /// %Worker running probes
+    class Worker : public Support::Runnable {
+    protected:
+      /// The engine
+      LDS& lds;
+      /// Stop object
+      LDSStop _stop;
+      /// Options for the probe
+      Options opt;
+      /// Statistics for probes already finished
+      Statistics done;
+    public:
+      /// The probe engine
+      Sequential::Probe e;
+      /// Discrepancy of current probe
+      unsigned int d;
+      /// Whether the current probe has not yet finished
+      bool active;
+      /// Solutions found by the current probe not yet returned
+      Support::DynamicQueue<Space*,Heap> solutions;
+      /// Initialize for engine \a l
+      Worker(LDS& l);
+      /// Start probe for space \a s and discrepancy \a d
+      void start(Space* s, unsigned int d);
+      /// Stop probe and forget all solutions
+      void reset(void);
+      /// Return statistics
+      Statistics statistics(void) const;
+      /// Return stop object
+      LDSStop& stop(void);
+      /// Run current probe until it finds a solution or finishes
+      virtual void run(void);
+      /// Delete worker
+      virtual ~Worker(void);
+    };
+    /// Search options
+    Options opt;
+    /// Root space (NULL if failed)
+    Space* root;
+    /// Smallest discrepancy for which solutions are still returned
+    unsigned int d;
+    /// Statistics for the root space
+    Statistics stat;
+    /// Workers
+    Worker** workers;
+    /// Number of workers
+    unsigned int n_workers;
+    /// Whether search has been stopped
+    bool w_stop;
+    /// Shared stop flag
+    volatile bool tostop;
+    /// Mutex for synchronization
+    Support::Mutex m;
+    /// Number of busy workers
+    unsigned int n_busy;
+    /// Signal that number of busy workers becomes zero
+    Support::Event idle;
+    /// Start all probes for space \a s
+    void start(Space* s);
+  public:
+    /// \name Interface for workers
+    //@{
+    /// Report that worker \a w has found solution \a s or stopped
+    void report(Worker* w, Space* s);
+    /// Return options
+    const Options& options(void) const;
+    //@}
+    /// \name Engine interface
+    //@{
+    /// Initialize for space \a s with options \a o
+    LDS(Space* s, const Options& o);
+    /// Return next solution (NULL, if none exists or search has been stopped)
+    virtual Space* next(void);
+    /// Return statistics
+    virtual Statistics statistics(void) const;
+    /// Check whether engine has been stopped
+    virtual bool stopped(void) const;
+    /// Reset engine to restart at space \a s
+    virtual void reset(Space* s);
+    /// Destructor
+    virtual ~LDS(void);
+    //@}
+  };
+
+
+  forceinline
+  LDSStop::LDSStop(Stop* so0, volatile bool* ts)
+    : so(so0), tostop(ts), _user(false) {}
+
+  forceinline bool
+  LDSStop::user(void) const {
+    return _user;
+  }
+
+  forceinline void
+  LDSStop::reset(void) {
+    _user = false;
+  }
+
+  forceinline LDSStop&
+  LDS::Worker::stop(void) {
+    return _stop;
+  }
+
+  forceinline const Options&
+  LDS::options(void) const {
+    return opt;
+  }
+
+}}}
+
+#endif
+
+// STATISTICS: search-parallel
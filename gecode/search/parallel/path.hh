@@ -57,6 +57,11 @@ namespace Gecode { namespace Search { namespace Parallel {
    * distance is at least this large, an additional
    * clone is created.
    *
+   * Edges for the last alternative of a choice remain on the path
+   * even if their space has been reused, so that the path always
+   * describes the current node starting from the root (as required
+   * for distributed search).
+   *
    */
   class Path : public NoGoods {
     friend class Search::Meta::NoGoodsProp;
@@ -92,8 +97,6 @@ namespace Gecode { namespace Search { namespace Parallel {
       unsigned int truealt(void) const;
       /// Test whether current alternative is rightmost
       bool rightmost(void) const;
-      /// Test whether current alternative was LAO
-      bool lao(void) const;
       /// Test whether there is an alternative that can be stolen
       bool work(void) const;
       /// Move to next alternative
@@ -111,6 +114,10 @@ namespace Gecode { namespace Search { namespace Parallel {
     unsigned int _ngdl;
     /// Number of edges that have work for stealing
     unsigned int n_work;
+    /// Constrain space \a s to be better than solution \a b
+    static void better(Space& s, const Space& b);
+    /// Constrain space \a s to be better than objective bound \a b
+    static void better(Space& s, int b);
   public:
     /// Initialize with no-good depth limit \a l
     Path(unsigned int l);
@@ -134,9 +141,16 @@ namespace Gecode { namespace Search { namespace Parallel {
     void commit(Space* s, int i) const;
     /// Recompute space according to path
     Space* recompute(unsigned int& d, unsigned int a_d, Worker& s);
-    /// Recompute space according to path
+    /**
+     * \brief Recompute space according to path
+     *
+     * The spaces above \a mark are constrained by \a best which is
+     * either the best solution or the objective bound of the best
+     * solution.
+     */
+    template<class Best>
     Space* recompute(unsigned int& d, unsigned int a_d, Worker& s,
-                     const Space& best, int& mark);
+                     const Best& best, int& mark);
     /// Return number of entries on stack
     int entries(void) const;
     /// Reset stack and set no-good depth limit to \a l
@@ -145,6 +159,15 @@ namespace Gecode { namespace Search { namespace Parallel {
     bool steal(void) const;
     /// Steal work at depth \a d
     Space* steal(Worker& stat, unsigned long int& d);
+    /// Archive choices and alternatives in \a a and return number of edges
+    int archive(Archive& a) const;
+    /**
+     * \brief Steal work and archive the path leading to it in \a a
+     *
+     * Returns the number of edges archived (zero if there is no
+     * work that can be stolen).
+     */
+    int steal(Archive& a);
     /// Post no-goods
     void virtual post(Space& home) const;
   };
@@ -186,10 +209,6 @@ namespace Gecode { namespace Search { namespace Parallel {
     return _alt >= _alt_max;
   }
   forceinline bool
-  Path::Edge::lao(void) const {
-    return _alt > _alt_max;
-  }
-  forceinline bool
   Path::Edge::work(void) const {
     return _alt < _alt_max;
   }
@@ -237,10 +256,6 @@ namespace Gecode { namespace Search { namespace Parallel {
 
   forceinline const Choice*
   Path::push(Worker& stat, Space* s, Space* c) {
-    if (!ds.empty() && ds.top().lao()) {
-      // Topmost stack entry was LAO -> reuse
-      ds.pop().dispose();
-    }
     Edge sn(s,c);
     if (sn.work())
       n_work++;
@@ -349,6 +364,43 @@ namespace Gecode { namespace Search { namespace Parallel {
     return NULL;
   }
 
+  inline int
+  Path::archive(Archive& a) const {
+    int n = ds.entries();
+    for (int i=0; i<n; i++) {
+      a << ds[i].alt();
+      ds[i].choice()->archive(a);
+    }
+    return n;
+  }
+
+  inline int
+  Path::steal(Archive& a) {
+    // Find position to steal: leave sufficient work
+    int n = ds.entries()-1;
+    unsigned int w = 0;
+    while (n >= 0) {
+      if (ds[n].work())
+        w++;
+      if (w > Config::steal_limit) {
+        // Okay, there is sufficient work left
+        for (int i=0; i<n; i++) {
+          a << ds[i].alt();
+          ds[i].choice()->archive(a);
+        }
+        a << ds[n].steal();
+        ds[n].choice()->archive(a);
+        if (!ds[n].work())
+          n_work--;
+        // No no-goods can be extracted above n
+        ngdl(std::min(ngdl(),static_cast<unsigned int>(n)));
+        return n+1;
+      }
+      n--;
+    }
+    return 0;
+  }
+
   forceinline Space*
   Path::recompute(unsigned int& d, unsigned int a_d, Worker& stat) {
     assert(!ds.empty());
@@ -361,9 +413,6 @@ namespace Gecode { namespace Search { namespace Parallel {
       s->commit(*ds.top().choice(),ds.top().alt());
       assert(ds.entries()-1 == lc());
       ds.top().space(NULL);
-      // Mark as reusable
-      if (static_cast<unsigned int>(ds.entries()) > ngdl())
-        ds.top().next();
       d = 0;
       return s;
     }
@@ -413,9 +462,19 @@ namespace Gecode { namespace Search { namespace Parallel {
     return s;
   }
 
+  forceinline void
+  Path::better(Space& s, const Space& b) {
+    s.constrain(b);
+  }
+  forceinline void
+  Path::better(Space& s, int b) {
+    s.improve(b);
+  }
+
+  template<class Best>
   forceinline Space*
   Path::recompute(unsigned int& d, unsigned int a_d, Worker& stat,
-                  const Space& best, int& mark) {
+                  const Best& best, int& mark) {
     assert(!ds.empty());
     // Recompute space according to path
     // Also say distance to copy (d == 0) requires immediate copying
@@ -427,12 +486,9 @@ namespace Gecode { namespace Search { namespace Parallel {
       assert(ds.entries()-1 == lc());
       if (mark > ds.entries()-1) {
         mark = ds.entries()-1;
-        s->constrain(best);
+        better(*s,best);
       }
       ds.top().space(NULL);
-      // Mark as reusable
-      if (static_cast<unsigned int>(ds.entries()) > ngdl())
-        ds.top().next();
       d = 0;
       return s;
     }
@@ -446,7 +502,7 @@ namespace Gecode { namespace Search { namespace Parallel {
 
     if (l < mark) {
       mark = l;
-      s->constrain(best);
+      better(*s,best);
       // The space on the stack could be failed now as an additional
       // constraint might have been added.
       if (s->status(stat) == SS_FAILED) {
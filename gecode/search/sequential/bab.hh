@@ -45,6 +45,7 @@
 #include <gecode/search.hh>
 #include <gecode/search/support.hh>
 #include <gecode/search/worker.hh>
+#include <gecode/search/distance.hh>
 #include <gecode/search/sequential/path.hh>
 
 namespace Gecode { namespace Search { namespace Sequential {
@@ -60,10 +61,16 @@ namespace Gecode { namespace Search { namespace Sequential {
     Space* cur;
     /// Distance until next clone
     unsigned int d;
+    /// Commit and adaptive distance
+    Distance dist;
     /// Number of entries not yet constrained to be better
     int mark;
     /// Best solution found so far
     Space* best;
+    /// Number of solutions archived in \a sols
+    unsigned int n_sols;
+    /// Paths to the solutions found so far (for checkpointing)
+    Archive sols;
   public:
     /// Initialize with space \a s and search options \a o
     BAB(Space* s, const Options& o);
@@ -77,13 +84,18 @@ namespace Gecode { namespace Search { namespace Sequential {
     void reset(Space* s);
     /// Return no-goods
     NoGoods& nogoods(void);
+    /// Archive state of engine in \a a
+    void checkpoint(Archive& a) const;
+    /// Restore state of engine from \a a and return best solution
+    Space* restore(Archive& a);
     /// Destructor
     ~BAB(void);
   };
 
   forceinline
   BAB::BAB(Space* s, const Options& o)
-    : opt(o), path(opt.nogoods_limit), d(0), mark(0), best(NULL) {
+    : opt(o), path(opt.nogoods_limit), d(0), dist(opt),
+      mark(0), best(NULL), n_sols(0) {
     if ((s == NULL) || (s->status(*this) == SS_FAILED)) {
       fail++;
       cur = NULL;
@@ -116,17 +128,20 @@ namespace Gecode { namespace Search { namespace Sequential {
     while (true) {
       if (stop(opt))
         return NULL;
+      // Whether the current space has been recomputed
+      bool r = false;
       // Recompute and add constraint if necessary
       while (cur == NULL) {
         if (path.empty())
           return NULL;
-        cur = path.recompute(d,opt.a_d,*this,*best,mark);
+        cur = path.recompute(d,dist.a_d(),*this,*best,mark);
+        r = true;
         if (cur != NULL)
           break;
         path.next();
       }
       node++;
-      switch (cur->status(*this)) {
+      switch (dist.status(*cur,r,*this)) {
       case SS_FAILED:
         fail++;
         delete cur;
@@ -136,6 +151,8 @@ namespace Gecode { namespace Search { namespace Sequential {
       case SS_SOLVED:
         // Deletes all pending branchers
         (void) cur->choice();
+        // The path points to the solution
+        path.archive(sols); n_sols++;
         delete best;
         best = cur;
         cur = NULL;
@@ -145,8 +162,8 @@ namespace Gecode { namespace Search { namespace Sequential {
       case SS_BRANCH:
         {
           Space* c;
-          if ((d == 0) || (d >= opt.c_d)) {
-            c = cur->clone();
+          if ((d == 0) || (d >= dist.c_d())) {
+            c = dist.clone(*cur);
             d = 1;
           } else {
             c = NULL;
@@ -166,7 +183,9 @@ namespace Gecode { namespace Search { namespace Sequential {
 
   forceinline Statistics
   BAB::statistics(void) const {
-    return *this;
+    Statistics s = *this;
+    dist.statistics(s);
+    return s;
   }
 
   forceinline void
@@ -183,12 +202,15 @@ namespace Gecode { namespace Search { namespace Sequential {
     if (cur != NULL)
       cur->constrain(b);
     mark = path.entries();
+    // Solutions not found by the engine cannot be archived
+    sols = Archive(); n_sols = 0;
   }
 
   forceinline void
   BAB::reset(Space* s) {
     delete best;
     best = NULL;
+    sols = Archive(); n_sols = 0;
     path.reset();
     d = 0;
     mark = 0;
@@ -207,6 +229,60 @@ namespace Gecode { namespace Search { namespace Sequential {
     return path;
   }
 
+  forceinline void
+  BAB::checkpoint(Archive& a) const {
+    a << 'B';
+    Worker::archive(a);
+    a << (cur != NULL);
+    path.archive(a);
+    a << n_sols << sols.size();
+    for (int i=0; i<sols.size(); i++)
+      a << sols[i];
+  }
+
+  forceinline Space*
+  BAB::restore(Archive& a) {
+    if ((a.size() == 0) || (a.get() != 'B'))
+      throw IllegalCheckpoint("BAB::restore");
+    Worker::unarchive(a);
+    bool c; a >> c;
+    // The current space is the root space (or NULL if it failed)
+    if (cur == NULL)
+      return NULL;
+    path.unarchive(a,*cur);
+    int n; a >> n_sols >> n;
+    for (int i=0; i<n; i++)
+      sols << a.get();
+    /*
+     * Recompute the best solution: each solution is better than its
+     * predecessor and hence can be recomputed from the root space
+     * constrained by the predecessor.
+     */
+    for (unsigned int i=0; i<n_sols; i++) {
+      Space* s = Path::replay(sols,*cur);
+      if (best != NULL)
+        s->constrain(*best);
+      if (s->status(*this) == SS_SOLVED) {
+        // Deletes all pending branchers
+        (void) s->choice();
+        delete best;
+        best = s;
+      } else {
+        delete s;
+      }
+    }
+    if (!path.empty() || !c) {
+      delete cur;
+      cur = NULL;
+    } else if (best != NULL) {
+      cur->constrain(*best);
+    }
+    // No space on the path is guaranteed to be better
+    mark = (best != NULL) ? path.entries() : 0;
+    d = 0;
+    return (best != NULL) ? best->clone() : NULL;
+  }
+
   forceinline
   BAB::~BAB(void) {
     path.reset();
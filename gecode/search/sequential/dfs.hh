@@ -41,6 +41,7 @@
 #include <gecode/search.hh>
 #include <gecode/search/support.hh>
 #include <gecode/search/worker.hh>
+#include <gecode/search/distance.hh>
 #include <gecode/search/sequential/path.hh>
 
 namespace Gecode { namespace Search { namespace Sequential {
@@ -56,6 +57,8 @@ namespace Gecode { namespace Search { namespace Sequential {
     Space* cur;
     /// Distance until next clone
     unsigned int d;
+    /// Commit and adaptive distance
+    Distance dist;
   public:
     /// Initialize for space \a s with options \a o
     DFS(Space* s, const Options& o);
@@ -69,13 +72,17 @@ namespace Gecode { namespace Search { namespace Sequential {
     void reset(Space* s);
     /// Return no-goods
     NoGoods& nogoods(void);
+    /// Archive state of engine in \a a
+    void checkpoint(Archive& a) const;
+    /// Restore state of engine from \a a (returns NULL)
+    Space* restore(Archive& a);
     /// Destructor
     ~DFS(void);
   };
 
   forceinline
   DFS::DFS(Space* s, const Options& o)
-    : opt(o), path(opt.nogoods_limit), d(0) {
+    : opt(o), path(opt.nogoods_limit), d(0), dist(opt) {
     if ((s == NULL) || (s->status(*this) == SS_FAILED)) {
       fail++;
       cur = NULL;
@@ -122,16 +129,19 @@ namespace Gecode { namespace Search { namespace Sequential {
     while (true) {
       if (stop(opt))
         return NULL;
+      // Whether the current space has been recomputed
+      bool r = false;
       while (cur == NULL) {
         if (path.empty())
           return NULL;
-        cur = path.recompute(d,opt.a_d,*this);
+        cur = path.recompute(d,dist.a_d(),*this);
+        r = true;
         if (cur != NULL)
           break;
         path.next();
       }
       node++;
-      switch (cur->status(*this)) {
+      switch (dist.status(*cur,r,*this)) {
       case SS_FAILED:
         fail++;
         delete cur;
@@ -150,8 +160,8 @@ namespace Gecode { namespace Search { namespace Sequential {
       case SS_BRANCH:
         {
           Space* c;
-          if ((d == 0) || (d >= opt.c_d)) {
-            c = cur->clone();
+          if ((d == 0) || (d >= dist.c_d())) {
+            c = dist.clone(*cur);
             d = 1;
           } else {
             c = NULL;
@@ -171,7 +181,9 @@ namespace Gecode { namespace Search { namespace Sequential {
 
   forceinline Statistics
   DFS::statistics(void) const {
-    return *this;
+    Statistics s = *this;
+    dist.statistics(s);
+    return s;
   }
 
   forceinline void
@@ -180,6 +192,37 @@ namespace Gecode { namespace Search { namespace Sequential {
     assert(false);
   }
 
+  forceinline void
+  DFS::checkpoint(Archive& a) const {
+    a << 'D';
+    Worker::archive(a);
+    a << (cur != NULL);
+    path.archive(a);
+  }
+
+  forceinline Space*
+  DFS::restore(Archive& a) {
+    if ((a.size() == 0) || (a.get() != 'D'))
+      throw IllegalCheckpoint("DFS::restore");
+    Worker::unarchive(a);
+    bool c; a >> c;
+    // The current space is the root space (or NULL if it failed)
+    if (cur == NULL)
+      return NULL;
+    path.unarchive(a,*cur);
+    /*
+     * If the path is not empty it points to the next space to be
+     * explored, which is recomputed by next(). If the path is empty,
+     * search either has not yet started or is exhausted.
+     */
+    if (!path.empty() || !c) {
+      delete cur;
+      cur = NULL;
+    }
+    d = 0;
+    return NULL;
+  }
+
   forceinline
   DFS::~DFS(void) {
     delete cur;
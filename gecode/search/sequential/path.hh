@@ -57,6 +57,11 @@ namespace Gecode { namespace Search { namespace Sequential {
    * distance is at least this large, an additional
    * clone is created.
    *
+   * Edges for the last alternative of a choice remain on the path
+   * even if their space has been reused, so that the path always
+   * describes the current node starting from the root (as required
+   * for checkpointing).
+   *
    */
   class GECODE_VTABLE_EXPORT Path : public NoGoods {
     friend class Search::Meta::NoGoodsProp;
@@ -75,6 +80,8 @@ namespace Gecode { namespace Search { namespace Sequential {
       Edge(void);
       /// Edge for space \a s with clone \a c (possibly NULL)
       Edge(Space* s, Space* c);
+      /// Edge for choice \a ch at alternative \a a with clone \a c
+      Edge(const Choice* ch, unsigned int a, Space* c);
 
       /// Return space for edge
       Space* space(void) const;
@@ -94,8 +101,6 @@ namespace Gecode { namespace Search { namespace Sequential {
       bool rightmost(void) const;
       /// Move to next alternative
       void next(void);
-      /// Test whether current alternative was LAO
-      bool lao(void) const;
 
       /// Free memory for edge
       void dispose(void);
@@ -137,6 +142,12 @@ namespace Gecode { namespace Search { namespace Sequential {
     void reset(void);
     /// Post no-goods
     GECODE_SEARCH_EXPORT virtual void post(Space& home) const;
+    /// Archive choices and alternatives of the path in \a a
+    void archive(Archive& a) const;
+    /// Restore path from \a a with clone of root space \a s
+    void unarchive(Archive& a, const Space& s);
+    /// Recompute space for path archived in \a a from root space \a s
+    static Space* replay(Archive& a, const Space& s);
   };
 
 
@@ -151,6 +162,10 @@ namespace Gecode { namespace Search { namespace Sequential {
   Path::Edge::Edge(Space* s, Space* c)
     : _space(c), _alt(0), _choice(s->choice()) {}
 
+  forceinline
+  Path::Edge::Edge(const Choice* ch, unsigned int a, Space* c)
+    : _space(c), _alt(a), _choice(ch) {}
+
   forceinline Space*
   Path::Edge::space(void) const {
     return _space;
@@ -177,10 +192,6 @@ namespace Gecode { namespace Search { namespace Sequential {
   Path::Edge::rightmost(void) const {
     return _alt+1 >= _choice->alternatives();
   }
-  forceinline bool
-  Path::Edge::lao(void) const {
-    return _alt >= _choice->alternatives();
-  }
   forceinline void
   Path::Edge::next(void) {
     _alt++;
@@ -220,10 +231,6 @@ namespace Gecode { namespace Search { namespace Sequential {
 
   forceinline const Choice*
   Path::push(Worker& stat, Space* s, Space* c) {
-    if (!ds.empty() && ds.top().lao()) {
-      // Topmost stack entry was LAO -> reuse
-      ds.pop().dispose();
-    }
     Edge sn(s,c);
     ds.push(sn);
     stat.stack_depth(static_cast<unsigned long int>(ds.entries()));
@@ -286,6 +293,47 @@ namespace Gecode { namespace Search { namespace Sequential {
       ds.pop().dispose();
   }
 
+  inline void
+  Path::archive(Archive& a) const {
+    int n = ds.entries();
+    a << n;
+    for (int i=0; i<n; i++) {
+      a << ds[i].alt();
+      ds[i].choice()->archive(a);
+    }
+  }
+
+  inline void
+  Path::unarchive(Archive& a, const Space& s) {
+    reset();
+    int n; a >> n;
+    if (n == 0)
+      return;
+    // Choices are created by and committed to a copy of the root space
+    Space* c = s.clone();
+    for (int i=0; i<n; i++) {
+      unsigned int alt; a >> alt;
+      const Choice* ch = c->choice(a);
+      Edge e(ch, alt, (i == 0) ? s.clone() : NULL);
+      ds.push(e);
+      c->commit(*ch,alt);
+    }
+    delete c;
+  }
+
+  inline Space*
+  Path::replay(Archive& a, const Space& s) {
+    Space* c = s.clone();
+    int n; a >> n;
+    for (int i=0; i<n; i++) {
+      unsigned int alt; a >> alt;
+      const Choice* ch = c->choice(a);
+      c->commit(*ch,alt);
+      delete ch;
+    }
+    return c;
+  }
+
   forceinline Space*
   Path::recompute(unsigned int& d, unsigned int a_d, Worker& stat) {
     assert(!ds.empty());
@@ -298,9 +346,6 @@ namespace Gecode { namespace Search { namespace Sequential {
       s->commit(*ds.top().choice(),ds.top().alt());
       assert(ds.entries()-1 == lc());
       ds.top().space(NULL);
-      // Mark as reusable
-      if (static_cast<unsigned int>(ds.entries()) > ngdl())
-        ds.top().next();
       d = 0;
       return s;
     }
@@ -367,9 +412,6 @@ namespace Gecode { namespace Search { namespace Sequential {
         s->constrain(best);
       }
       ds.top().space(NULL);
-      // Mark as reusable
-      if (static_cast<unsigned int>(ds.entries()) > ngdl())
-        ds.top().next();
       d = 0;
       return s;
     }
@@ -42,13 +42,13 @@ namespace Gecode { namespace Search {
   forceinline void
   Statistics::reset(void) {
     StatusStatistics::reset();
-    fail=0; node=0; depth=0; restart=0; nogood=0;
+    fail=0; node=0; depth=0; restart=0; nogood=0; c_d=0; a_d=0;
   }
 
   forceinline
   Statistics::Statistics(void)
     : fail(0), node(0), depth(0),
-      restart(0), nogood(0) {}
+      restart(0), nogood(0), c_d(0), a_d(0) {}
 
   forceinline Statistics&
   Statistics::operator +=(const Statistics& s) {
@@ -58,6 +58,8 @@ namespace Gecode { namespace Search {
     depth = std::max(depth,s.depth);
     restart += s.restart;
     nogood += s.nogood;
+    c_d = std::max(c_d,s.c_d);
+    a_d = std::max(a_d,s.a_d);
     return *this;
   }
 
@@ -67,6 +67,10 @@ namespace Gecode { namespace Search {
     virtual void reset(Space* s);
     /// Return no-goods
     virtual NoGoods& nogoods(void);
+    /// Archive state of engine in \a a
+    virtual void checkpoint(Archive& a) const;
+    /// Restore state of engine from \a a and return best solution
+    virtual Space* restore(Archive& a);
   };
 
 
@@ -110,6 +114,16 @@ namespace Gecode { namespace Search {
   WorkerToEngine<Worker>::nogoods(void) {
     return w.nogoods();
   }
+  template<class Worker>
+  void
+  WorkerToEngine<Worker>::checkpoint(Archive& a) const {
+    w.checkpoint(a);
+  }
+  template<class Worker>
+  Space*
+  WorkerToEngine<Worker>::restore(Archive& a) {
+    return w.restore(a);
+  }
 
 }}
 
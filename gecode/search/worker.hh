@@ -66,6 +66,10 @@ namespace Gecode { namespace Search {
     void stack_depth(unsigned long int d);
     /// Return steal depth
     unsigned long int steal_depth(unsigned long int d) const;
+    /// Archive statistics in \a a
+    void archive(Archive& a) const;
+    /// Restore statistics from \a a
+    void unarchive(Archive& a);
   };
 
 
@@ -111,6 +115,25 @@ namespace Gecode { namespace Search {
     return root_depth + d;
   }
 
+  forceinline void
+  Worker::archive(Archive& a) const {
+    const unsigned long int s[] = {fail, node, depth, restart, nogood};
+    // Split into two words as unsigned long int might have 64 bits
+    for (int i=0; i<5; i++)
+      a << static_cast<unsigned int>(s[i] & 0xffffffffUL)
+        << static_cast<unsigned int>((s[i] >> 16) >> 16);
+  }
+
+  forceinline void
+  Worker::unarchive(Archive& a) {
+    unsigned long int* s[] = {&fail, &node, &depth, &restart, &nogood};
+    for (int i=0; i<5; i++) {
+      unsigned int l, h;
+      a >> l >> h;
+      *s[i] = ((static_cast<unsigned long int>(h) << 16) << 16) | l;
+    }
+  }
+
 }}
 
 #endif
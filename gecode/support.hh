@@ -103,6 +103,7 @@
 #include <gecode/support/exception.hpp>
 #include <gecode/support/cast.hpp>
 #include <gecode/support/thread.hpp>
+#include <gecode/support/atomic.hpp>
 #include <gecode/support/allocator.hpp>
 #include <gecode/support/heap.hpp>
 #include <gecode/support/marked-pointer.hpp>
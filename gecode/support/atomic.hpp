@@ -0,0 +1,226 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+ * Configure atomic operations
+ *
+ * Atomic operations are available if the platform has no threads
+ * at all or if the compiler offers lock-free builtins for 64-bit
+ * quantities.
+ *
+ */
+#ifdef GECODE_HAS_THREADS
+
+#if defined(__GNUC__) && defined(__GCC_ATOMIC_LLONG_LOCK_FREE)
+#if __GCC_ATOMIC_LLONG_LOCK_FREE == 2
+#define GECODE_SUPPORT_ATOMIC_GCC
+#endif
+#elif defined(_MSC_VER) && defined(_WIN64)
+#define GECODE_SUPPORT_ATOMIC_MSVC
+#endif
+
+#if defined(GECODE_SUPPORT_ATOMIC_GCC) || defined(GECODE_SUPPORT_ATOMIC_MSVC)
+#define GECODE_HAS_ATOMICS
+#endif
+
+#else
+
+#define GECODE_HAS_ATOMICS
+
+#endif
+
+namespace Gecode { namespace Support {
+
+  /**
+   * \brief Atomic operations on shared memory
+   *
+   * The operations are defined for 32-bit and 64-bit integral and
+   * floating point types. They are only lock-free if the macro
+   * GECODE_HAS_ATOMICS is defined, otherwise they must only be used
+   * by a single thread.
+   *
+   * \ingroup FuncSupportThread
+   */
+  //@{
+  /// Return value of \a x
+  template<class T>
+  T atomic_load(const T& x);
+  /// Set \a x to \a v
+  template<class T>
+  void atomic_store(T& x, T v);
+  /**
+   * \brief Replace \a x by \a n if \a x is equal to \a o
+   *
+   * Returns whether \a x has been replaced. If not, \a o is updated
+   * to the current value of \a x.
+   */
+  template<class T>
+  bool atomic_cas(T& x, T& o, T n);
+  /// Increment \a x and return the incremented value
+  template<class T>
+  T atomic_inc(T& x);
+  /// Add \a a to \a x
+  template<class T>
+  void atomic_add(T& x, T a);
+  /// Multiply \a x by \a a
+  template<class T>
+  void atomic_mul(T& x, T a);
+  //@}
+
+
+#ifdef GECODE_SUPPORT_ATOMIC_MSVC
+
+  /// Interlocked operations depending on operand size
+  template<size_t n>
+  class Interlocked;
+
+  /// Interlocked operations on 32-bit quantities
+  template<>
+  class Interlocked<4> {
+  public:
+    /// Compare and swap on bit patterns
+    static bool cas(void* x, void* o, const void* n) {
+      long lo, ln;
+      std::memcpy(&lo,o,4); std::memcpy(&ln,n,4);
+      long r = _InterlockedCompareExchange(static_cast<volatile long*>(x),
+                                           ln,lo);
+      if (r == lo)
+        return true;
+      std::memcpy(o,&r,4);
+      return false;
+    }
+  };
+
+  /// Interlocked operations on 64-bit quantities
+  template<>
+  class Interlocked<8> {
+  public:
+    /// Compare and swap on bit patterns
+    static bool cas(void* x, void* o, const void* n) {
+      __int64 lo, ln;
+      std::memcpy(&lo,o,8); std::memcpy(&ln,n,8);
+      __int64 r =
+        _InterlockedCompareExchange64(static_cast<volatile __int64*>(x),
+                                      ln,lo);
+      if (r == lo)
+        return true;
+      std::memcpy(o,&r,8);
+      return false;
+    }
+  };
+
+#endif
+
+  template<class T>
+  forceinline T
+  atomic_load(const T& x) {
+#if defined(GECODE_SUPPORT_ATOMIC_GCC)
+    T r;
+    __atomic_load(const_cast<T*>(&x),&r,__ATOMIC_ACQUIRE);
+    return r;
+#elif defined(GECODE_SUPPORT_ATOMIC_MSVC)
+    // Aligned loads up to 64 bits are atomic on all Windows targets
+    _ReadWriteBarrier();
+    T r = *static_cast<const volatile T*>(&x);
+    _ReadWriteBarrier();
+    return r;
+#else
+    return x;
+#endif
+  }
+
+  template<class T>
+  forceinline void
+  atomic_store(T& x, T v) {
+#if defined(GECODE_SUPPORT_ATOMIC_GCC)
+    __atomic_store(&x,&v,__ATOMIC_RELEASE);
+#elif defined(GECODE_SUPPORT_ATOMIC_MSVC)
+    T o = atomic_load(x);
+    while (!Interlocked<sizeof(T)>::cas(&x,&o,&v)) {}
+#else
+    x = v;
+#endif
+  }
+
+  template<class T>
+  forceinline bool
+  atomic_cas(T& x, T& o, T n) {
+#if defined(GECODE_SUPPORT_ATOMIC_GCC)
+    return __atomic_compare_exchange(&x,&o,&n,false,
+                                     __ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE);
+#elif defined(GECODE_SUPPORT_ATOMIC_MSVC)
+    return Interlocked<sizeof(T)>::cas(&x,&o,&n);
+#else
+    if (std::memcmp(&x,&o,sizeof(T)) == 0) {
+      x = n; return true;
+    } else {
+      o = x; return false;
+    }
+#endif
+  }
+
+  template<class T>
+  forceinline T
+  atomic_inc(T& x) {
+    T o = atomic_load(x);
+    while (!atomic_cas(x,o,static_cast<T>(o+1))) {}
+    return static_cast<T>(o+1);
+  }
+
+  template<class T>
+  forceinline void
+  atomic_add(T& x, T a) {
+    T o = atomic_load(x);
+    while (!atomic_cas(x,o,static_cast<T>(o+a))) {}
+  }
+
+  template<class T>
+  forceinline void
+  atomic_mul(T& x, T a) {
+    T o = atomic_load(x);
+    while (!atomic_cas(x,o,static_cast<T>(o*a))) {}
+  }
+
+}}
+
+// STATISTICS: support-any
@@ -0,0 +1,238 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/support.hh>
+
+#if defined(__GNUC__) && defined(__x86_64__) && \
+    ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define GECODE_SUPPORT_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Gecode { namespace Support {
+
+  namespace {
+
+    /*
+     * Portable scalar kernels
+     *
+     */
+    void
+    scalar_inter(BitSetData* d, const BitSetData* s, unsigned int n) {
+      for (unsigned int i=0; i<n; i++)
+        d[i].a(s[i]);
+    }
+    void
+    scalar_unite(BitSetData* d, const BitSetData* s, unsigned int n) {
+      for (unsigned int i=0; i<n; i++)
+        d[i].o(s[i]);
+    }
+    void
+    scalar_minus(BitSetData* d, const BitSetData* s, unsigned int n) {
+      for (unsigned int i=0; i<n; i++)
+        d[i].a(BitSetData::neg(s[i]));
+    }
+    unsigned int
+    scalar_count(const BitSetData* d, unsigned int n) {
+      unsigned int c = 0;
+      for (unsigned int i=0; i<n; i++)
+        c += d[i].count();
+      return c;
+    }
+    unsigned int
+    scalar_find(const BitSetData* d, unsigned int i, unsigned int n) {
+      while ((i < n) && d[i].none())
+        i++;
+      return i;
+    }
+
+#ifdef GECODE_SUPPORT_X86_KERNELS
+
+    /*
+     * Kernels using the population count instruction (SSE4.2)
+     *
+     */
+    __attribute__ ((target("popcnt"))) unsigned int
+    sse42_count(const BitSetData* d, unsigned int n) {
+      const unsigned long int* w =
+        reinterpret_cast<const unsigned long int*>(d);
+      unsigned int c = 0;
+      for (unsigned int i=0; i<n; i++)
+        c += static_cast<unsigned int>(__builtin_popcountl(w[i]));
+      return c;
+    }
+
+    /*
+     * Kernels using 256-bit vector instructions (AVX2)
+     *
+     */
+    /// Number of words per vector
+    const unsigned int avx2_wpv = 32U / sizeof(BitSetData);
+
+    __attribute__ ((target("avx2"))) void
+    avx2_inter(BitSetData* d, const BitSetData* s, unsigned int n) {
+      unsigned int i = 0;
+      for ( ; i+avx2_wpv <= n; i += avx2_wpv) {
+        __m256i* vd = reinterpret_cast<__m256i*>(d+i);
+        const __m256i* vs = reinterpret_cast<const __m256i*>(s+i);
+        _mm256_storeu_si256(vd, _mm256_and_si256(_mm256_loadu_si256(vd),
+                                                 _mm256_loadu_si256(vs)));
+      }
+      scalar_inter(d+i,s+i,n-i);
+    }
+    __attribute__ ((target("avx2"))) void
+    avx2_unite(BitSetData* d, const BitSetData* s, unsigned int n) {
+      unsigned int i = 0;
+      for ( ; i+avx2_wpv <= n; i += avx2_wpv) {
+        __m256i* vd = reinterpret_cast<__m256i*>(d+i);
+        const __m256i* vs = reinterpret_cast<const __m256i*>(s+i);
+        _mm256_storeu_si256(vd, _mm256_or_si256(_mm256_loadu_si256(vd),
+                                                _mm256_loadu_si256(vs)));
+      }
+      scalar_unite(d+i,s+i,n-i);
+    }
+    __attribute__ ((target("avx2"))) void
+    avx2_minus(BitSetData* d, const BitSetData* s, unsigned int n) {
+      unsigned int i = 0;
+      for ( ; i+avx2_wpv <= n; i += avx2_wpv) {
+        __m256i* vd = reinterpret_cast<__m256i*>(d+i);
+        const __m256i* vs = reinterpret_cast<const __m256i*>(s+i);
+        // Note that andnot complements its first argument
+        _mm256_storeu_si256(vd, _mm256_andnot_si256(_mm256_loadu_si256(vs),
+                                                    _mm256_loadu_si256(vd)));
+      }
+      scalar_minus(d+i,s+i,n-i);
+    }
+    /**
+     * \brief Count bits by table lookup for nibbles
+     *
+     * The algorithm is taken from: Wojciech Mula, Nathan Kurz, Daniel
+     * Lemire, Faster Population Counts Using AVX2 Instructions,
+     * arXiv:1611.07612, 2016.
+     */
+    __attribute__ ((target("avx2,popcnt"))) unsigned int
+    avx2_count(const BitSetData* d, unsigned int n) {
+      const __m256i lookup =
+        _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                         0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+      const __m256i low = _mm256_set1_epi8(0x0f);
+      __m256i acc = _mm256_setzero_si256();
+      unsigned int i = 0;
+      for ( ; i+avx2_wpv <= n; i += avx2_wpv) {
+        __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d+i));
+        __m256i lo = _mm256_and_si256(v,low);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v,4),low);
+        __m256i c = _mm256_add_epi8(_mm256_shuffle_epi8(lookup,lo),
+                                    _mm256_shuffle_epi8(lookup,hi));
+        // Sum up the byte counts into 64-bit lanes (no overflow possible)
+        acc = _mm256_add_epi64(acc,
+                               _mm256_sad_epu8(c,_mm256_setzero_si256()));
+      }
+      unsigned int c =
+        static_cast<unsigned int>(_mm256_extract_epi64(acc,0) +
+                                  _mm256_extract_epi64(acc,1) +
+                                  _mm256_extract_epi64(acc,2) +
+                                  _mm256_extract_epi64(acc,3));
+      return c + sse42_count(d+i,n-i);
+    }
+    __attribute__ ((target("avx2"))) unsigned int
+    avx2_find(const BitSetData* d, unsigned int i, unsigned int n) {
+      for ( ; i+avx2_wpv <= n; i += avx2_wpv) {
+        __m256i v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d+i));
+        if (!_mm256_testz_si256(v,v))
+          break;
+      }
+      return scalar_find(d,i,n);
+    }
+
+#endif
+
+    /// Portable scalar kernels
+    const BitSetKernels scalar_kernels = {
+      &scalar_inter, &scalar_unite, &scalar_minus,
+      &scalar_count, &scalar_find, "scalar"
+    };
+
+#ifdef GECODE_SUPPORT_X86_KERNELS
+    /// Kernels for SSE4.2
+    const BitSetKernels sse42_kernels = {
+      &scalar_inter, &scalar_unite, &scalar_minus,
+      &sse42_count, &scalar_find, "sse4.2"
+    };
+    /// Kernels for AVX2
+    const BitSetKernels avx2_kernels = {
+      &avx2_inter, &avx2_unite, &avx2_minus,
+      &avx2_count, &avx2_find, "avx2"
+    };
+#endif
+
+    /// Select kernels for executing processor
+    const BitSetKernels*
+    select(void) {
+#ifdef GECODE_SUPPORT_X86_KERNELS
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        return &avx2_kernels;
+      if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+        return &sse42_kernels;
+#endif
+      return &scalar_kernels;
+    }
+
+  }
+
+  const BitSetKernels&
+  BitSetKernels::scalar(void) {
+    return scalar_kernels;
+  }
+
+  const BitSetKernels&
+  BitSetKernels::best(void) {
+    // Selected on first use (bitsets might be used during static initialization)
+    static const BitSetKernels* k = select();
+    return *k;
+  }
+
+}}
+
+#ifdef GECODE_SUPPORT_X86_KERNELS
+#undef GECODE_SUPPORT_X86_KERNELS
+#endif
+
+// STATISTICS: support-any
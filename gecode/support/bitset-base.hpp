@@ -47,11 +47,13 @@
 
 #if defined(_M_IX86)
 #pragma intrinsic(_BitScanForward)
+#pragma intrinsic(_BitScanReverse)
 #define GECODE_SUPPORT_MSVC_32
 #endif
 
 #if defined(_M_X64) || defined(_M_IA64)
 #pragma intrinsic(_BitScanForward64)
+#pragma intrinsic(_BitScanReverse64)
 #define GECODE_SUPPORT_MSVC_64
 #endif
 
@@ -74,10 +76,10 @@ namespace Gecode { namespace Support {
 #endif
     /// The bits
     Base bits;
+  public:
     /// Bits per base
     static const unsigned int bpb =
       static_cast<unsigned int>(CHAR_BIT * sizeof(Base));
-  public:
     /// Initialize with all bits set if \a setbits
     void init(bool setbits=false);
     /// Get number of data elements for \a s bits
@@ -92,6 +94,8 @@ namespace Gecode { namespace Support {
     void clear(unsigned int i);
     /// Return next set bit with position greater or equal to \a i (there must be a bit)
     unsigned int next(unsigned int i=0U) const;
+    /// Return previous set bit with position smaller or equal to \a i (there must be a bit)
+    unsigned int prev(unsigned int i) const;
     /// Whether all bits are set
     bool all(void) const;
     /// Whether all bits from bit 0 to bit \a i are set
@@ -112,6 +116,52 @@ namespace Gecode { namespace Support {
     void o(BitSetData a, unsigned int i);
     /// Return "or" of \a a and \a b
     static BitSetData o(BitSetData a, BitSetData b);
+    /// Return complement of \a a
+    static BitSetData neg(BitSetData a);
+    /// Test whether the bits are the same as for \a a
+    bool same(BitSetData a) const;
+    /// Return number of set bits
+    unsigned int count(void) const;
+  };
+
+  /**
+   * \brief Word kernels for bulk operations on bitset data
+   *
+   * The kernels operate on arrays of bitset data. Kernels using
+   * SIMD instructions are selected at runtime if supported by the
+   * executing processor, otherwise portable scalar kernels are used.
+   *
+   * As calling a kernel requires an indirect function call, kernels
+   * are only used for at least \a threshold words.
+   */
+  class BitSetKernels {
+  public:
+    /// Minimal number of words for which kernels are used
+    static const unsigned int threshold = 8U;
+    /// Kernel combining the \a n words of \a s into \a d
+    typedef void (*Binary)(BitSetData* d, const BitSetData* s,
+                           unsigned int n);
+    /// Kernel returning the number of set bits in the \a n words of \a d
+    typedef unsigned int (*Count)(const BitSetData* d, unsigned int n);
+    /// Kernel returning first non-zero word in \a d between \a i and \a n
+    typedef unsigned int (*Find)(const BitSetData* d,
+                                 unsigned int i, unsigned int n);
+    /// Intersection
+    Binary inter;
+    /// Union
+    Binary unite;
+    /// Difference
+    Binary minus;
+    /// Population count
+    Count count;
+    /// Scanning for a non-zero word (returns \a n if there is none)
+    Find find;
+    /// Name of instruction set used by kernels
+    const char* name;
+    /// Return portable scalar kernels
+    GECODE_SUPPORT_EXPORT static const BitSetKernels& scalar(void);
+    /// Return best kernels for executing processor
+    GECODE_SUPPORT_EXPORT static const BitSetKernels& best(void);
   };
 
   /// Status of a bitset
@@ -166,6 +216,14 @@ namespace Gecode { namespace Support {
     bool all(unsigned int sz) const;
     /// Test whether no bits are set
     bool none(unsigned int sz) const;
+    /// Return number of set bits
+    unsigned int count(unsigned int sz) const;
+    /// Intersect \a sz bits with bits from \a bs
+    void inter(unsigned int sz, const RawBitSetBase& bs);
+    /// Unite \a sz bits with bits from \a bs
+    void unite(unsigned int sz, const RawBitSetBase& bs);
+    /// Remove bits in \a bs from \a sz bits
+    void minus(unsigned int sz, const RawBitSetBase& bs);
     /// Resize bitset from \a sz to \a n elememts
     template<class A>
     void resize(A& a, unsigned int sz, unsigned int n, bool setbits=false);
@@ -216,6 +274,14 @@ namespace Gecode { namespace Support {
     bool all(void) const;
     /// Test whether no bits are set
     bool none(void) const;
+    /// Return number of set bits
+    unsigned int count(void) const;
+    /// Intersect with bits from \a bs
+    void inter(const BitSetBase& bs);
+    /// Unite with bits from \a bs
+    void unite(const BitSetBase& bs);
+    /// Remove bits in \a bs
+    void minus(const BitSetBase& bs);
     /// Resize bitset to \a n elememts
     template<class A>
     void resize(A& a, unsigned int n, bool setbits=false);
@@ -276,6 +342,30 @@ namespace Gecode { namespace Support {
 #else
     while (!get(i)) i++;
     return i;
+#endif
+  }
+  forceinline unsigned int
+  BitSetData::prev(unsigned int i) const {
+    assert(i < bpb);
+    // Shift so that bit i becomes the most significant bit
+    Base b = bits << (bpb-1U-i);
+    assert(b != static_cast<Base>(0));
+#if defined(GECODE_SUPPORT_MSVC_32)
+    unsigned long int p;
+    _BitScanReverse(&p,b);
+    return static_cast<unsigned int>(p)-(bpb-1U-i);
+#elif defined(GECODE_SUPPORT_MSVC_64)
+    unsigned long int p;
+    _BitScanReverse64(&p,b);
+    return static_cast<unsigned int>(p)-(bpb-1U-i);
+#elif defined(__GNUC__)
+    if (bpb == 64)
+      return i-static_cast<unsigned int>(__builtin_clzll(b));
+    else
+      return i-static_cast<unsigned int>(__builtin_clzl(b));
+#else
+    while (!get(i)) i--;
+    return i;
 #endif
   }
   forceinline bool
@@ -329,6 +419,37 @@ namespace Gecode { namespace Support {
     return ab;
   }
 
+  forceinline BitSetData
+  BitSetData::neg(BitSetData a) {
+    BitSetData na;
+    na.bits = ~a.bits;
+    return na;
+  }
+  forceinline bool
+  BitSetData::same(BitSetData a) const {
+    return bits == a.bits;
+  }
+  forceinline unsigned int
+  BitSetData::count(void) const {
+#if defined(__GNUC__)
+    if (bpb == 64)
+      return static_cast<unsigned int>(__builtin_popcountll(bits));
+    else
+      return static_cast<unsigned int>(__builtin_popcountl(bits));
+#else
+    // Count bits in parallel (SWAR)
+    Base b = bits;
+    const Base m1 = ~static_cast<Base>(0) / 3U;
+    const Base m2 = ~static_cast<Base>(0) / 5U;
+    const Base m4 = ~static_cast<Base>(0) / 17U;
+    const Base h1 = ~static_cast<Base>(0) / 255U;
+    b = b - ((b >> 1) & m1);
+    b = (b & m2) + ((b >> 2) & m2);
+    b = (b + (b >> 4)) & m4;
+    return static_cast<unsigned int>((b * h1) >> (bpb - 8U));
+#endif
+  }
+
 
   /*
    * Basic bit sets
@@ -476,6 +597,58 @@ namespace Gecode { namespace Support {
     return status(sz) == BSS_NONE;
   }
 
+  forceinline unsigned int
+  RawBitSetBase::count(unsigned int sz) const {
+    unsigned int pos = sz / bpb;
+    unsigned int bits = sz % bpb;
+    unsigned int c;
+    if (pos >= BitSetKernels::threshold) {
+      c = BitSetKernels::best().count(data,pos);
+    } else {
+      c = 0U;
+      for (unsigned int i=0; i<pos; i++)
+        c += data[i].count();
+    }
+    // Only count bits before the sentinel
+    BitSetData l; l.init(); l.o(data[pos],bits);
+    return c + l.count();
+  }
+
+  forceinline void
+  RawBitSetBase::inter(unsigned int sz, const RawBitSetBase& bs) {
+    unsigned int n = BitSetData::data(sz+1);
+    if (n >= BitSetKernels::threshold) {
+      BitSetKernels::best().inter(data,bs.data,n);
+    } else {
+      for (unsigned int i=0; i<n; i++)
+        data[i].a(bs.data[i]);
+    }
+  }
+
+  forceinline void
+  RawBitSetBase::unite(unsigned int sz, const RawBitSetBase& bs) {
+    unsigned int n = BitSetData::data(sz+1);
+    if (n >= BitSetKernels::threshold) {
+      BitSetKernels::best().unite(data,bs.data,n);
+    } else {
+      for (unsigned int i=0; i<n; i++)
+        data[i].o(bs.data[i]);
+    }
+  }
+
+  forceinline void
+  RawBitSetBase::minus(unsigned int sz, const RawBitSetBase& bs) {
+    unsigned int n = BitSetData::data(sz+1);
+    if (n >= BitSetKernels::threshold) {
+      BitSetKernels::best().minus(data,bs.data,n);
+    } else {
+      for (unsigned int i=0; i<n; i++)
+        data[i].a(BitSetData::neg(bs.data[i]));
+    }
+    // Restore the sentinel
+    set(sz);
+  }
+
 
   template<class A>
   void
@@ -545,7 +718,21 @@ namespace Gecode { namespace Support {
   forceinline unsigned int
   BitSetBase::next(unsigned int i) const {
     assert(i <= sz);
-    return RawBitSetBase::next(i);
+    unsigned int pos = i / bpb;
+    unsigned int bit = i % bpb;
+    if (data[pos](bit))
+      return pos * bpb + data[pos].next(bit);
+    // Scan long runs of empty words with the kernels
+    unsigned int n = BitSetData::data(sz+1);
+    pos++;
+    if (n - pos >= BitSetKernels::threshold) {
+      pos = BitSetKernels::best().find(data,pos,n);
+    } else {
+      // The sentinel bit guarantees that this loop always terminates
+      while (!data[pos]())
+        pos++;
+    }
+    return pos * bpb + data[pos].next();
   }
 
   forceinline BitSetStatus
@@ -563,6 +750,29 @@ namespace Gecode { namespace Support {
     return RawBitSetBase::none(sz);
   }
 
+  forceinline unsigned int
+  BitSetBase::count(void) const {
+    return RawBitSetBase::count(sz);
+  }
+
+  forceinline void
+  BitSetBase::inter(const BitSetBase& bs) {
+    assert(sz == bs.sz);
+    RawBitSetBase::inter(sz,bs);
+  }
+
+  forceinline void
+  BitSetBase::unite(const BitSetBase& bs) {
+    assert(sz == bs.sz);
+    RawBitSetBase::unite(sz,bs);
+  }
+
+  forceinline void
+  BitSetBase::minus(const BitSetBase& bs) {
+    assert(sz == bs.sz);
+    RawBitSetBase::minus(sz,bs);
+  }
+
 }}
 
 #ifdef GECODE_SUPPORT_MSVC_32
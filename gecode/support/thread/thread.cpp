@@ -60,8 +60,10 @@ namespace Gecode { namespace Support {
         e=r; r=NULL;
         m.release();
         assert(e != NULL);
+        // The runnable must not be accessed after it has been run
+        bool d = e->todelete();
         e->run();
-        if (e->todelete())
+        if (d)
           delete e;
       }
       // Put into idle stack
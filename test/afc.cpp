@@ -37,6 +37,9 @@
 
 #include <gecode/kernel.hh>
 #include <gecode/int.hh>
+#include <gecode/search.hh>
+
+#include <cmath>
 
 #include "test/test.hh"
 
@@ -138,6 +141,95 @@ namespace Test {
 
   AFC afc;
 
+  /// %Test for lock-free %AFC updates
+  class AFCLockFree : public Test::Base {
+  protected:
+    /// Test space
+    class TestSpace : public Gecode::Space {
+    public:
+      /// Integer variables
+      Gecode::IntVarArray x;
+      /// Constructor for creation
+      TestSpace(double d, bool lf) : x(*this,n,0,n-1) {
+        for (int i=0; i<n-1; i++)
+          Gecode::rel(*this, x[i], Gecode::IRT_NQ, x[i+1]);
+        if (d != 1.0)
+          afc_decay(d);
+        afc_lockfree(lf);
+        Gecode::branch(*this, x, Gecode::INT_VAR_AFC_MAX(d),
+                       Gecode::INT_VAL_MIN());
+      }
+      /// Constructor for cloning \a s
+      TestSpace(bool share, TestSpace& s) : Space(share,s) {
+        x.update(*this,share,s.x);
+      }
+      /// Copy during cloning
+      virtual Space* copy(bool share) {
+        return new TestSpace(share,*this);
+      }
+    };
+    /// Number of variables
+    static const int n = 5;
+    /// How many failures to provoke
+    static const int n_ops = 256;
+    /// Run failures \a o on a space with decay \a d and store AFC in \a a
+    void fail(double d, bool lf, const int o[], double a[]) {
+      TestSpace* s = new TestSpace(d,lf);
+      (void) s->status();
+      for (int i=0; i<n_ops; i++) {
+        TestSpace* c = static_cast<TestSpace*>(s->clone());
+        // Fails the propagator between the variables at p and p+1
+        int p = o[i] % (n-1), v = o[i] / (n-1);
+        Gecode::rel(*c, c->x[p], Gecode::IRT_EQ, v);
+        Gecode::rel(*c, c->x[p+1], Gecode::IRT_EQ, v);
+        (void) c->status();
+        delete c;
+      }
+      for (int i=0; i<n; i++)
+        a[i] = s->x[i].afc(*s);
+      delete s;
+    }
+  public:
+    /// Initialize test
+    AFCLockFree(void) : Test::Base("AFC::LockFree") {}
+    /// Perform actual tests
+    bool run(void) {
+      // Lock-free updates must agree with locked updates for one thread
+      int o[n_ops];
+      for (int i=0; i<n_ops; i++)
+        o[i] = static_cast<int>(rand((n-1)*n));
+      double ds[] = {1.0, 0.9};
+      for (int j=0; j<2; j++) {
+        double a[n], b[n];
+        fail(ds[j],false,o,a);
+        fail(ds[j],true,o,b);
+        for (int i=0; i<n; i++)
+          if (std::fabs(a[i]-b[i]) > 1e-9 * std::fabs(a[i]))
+            return false;
+      }
+      // Parallel search must find all solutions
+      for (int j=0; j<2; j++) {
+        Gecode::Search::Options so;
+        so.threads = 4;
+        so.afc_lockfree = true;
+        Gecode::DFS<TestSpace> e(new TestSpace(ds[j],false),so);
+        int s = 0;
+        while (TestSpace* t = e.next()) {
+          s++; delete t;
+        }
+        // Number of sequences over 0..n-1 with different neighbours
+        int m = n;
+        for (int i=1; i<n; i++)
+          m *= n-1;
+        if (s != m)
+          return false;
+      }
+      return true;
+    }
+  };
+
+  AFCLockFree afc_lockfree;
+
 }
 
 // STATISTICS: test-core
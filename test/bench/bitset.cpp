@@ -0,0 +1,152 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/support.hh>
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+/**
+ * \brief Microbenchmark for bitset word kernels
+ *
+ * Compares the throughput of the portable scalar kernels with the
+ * kernels selected for the executing processor for bitsets of
+ * different sizes.
+ *
+ * The optional commandline argument defines how many words are
+ * processed per measurement (default 2^26).
+ */
+
+using namespace Gecode;
+using namespace Gecode::Support;
+
+namespace {
+
+  /// Sink for results (to avoid that computations are optimized away)
+  volatile unsigned int sink = 0U;
+
+  /// Kernel operation to be measured
+  enum Operation {
+    OP_INTER, OP_UNITE, OP_MINUS, OP_COUNT, OP_FIND
+  };
+
+  /// Return name of operation \a o
+  const char*
+  name(Operation o) {
+    switch (o) {
+    case OP_INTER: return "inter";
+    case OP_UNITE: return "unite";
+    case OP_MINUS: return "minus";
+    case OP_COUNT: return "count";
+    case OP_FIND:  return "find";
+    default: GECODE_NEVER;
+    }
+    return NULL;
+  }
+
+  /// Return throughput in words per nanosecond for operation \a o
+  double
+  measure(const BitSetKernels& k, Operation o,
+          BitSetData* d, const BitSetData* s, unsigned int n,
+          unsigned long int total) {
+    unsigned long int rounds = std::max(total / n, 1UL);
+    Timer t;
+    t.start();
+    for (unsigned long int r=rounds; r--; )
+      switch (o) {
+      case OP_INTER: k.inter(d,s,n); break;
+      case OP_UNITE: k.unite(d,s,n); break;
+      case OP_MINUS: k.minus(d,s,n); break;
+      case OP_COUNT: sink = sink + k.count(s,n); break;
+      case OP_FIND:  sink = sink + k.find(d,0,n); break;
+      default: GECODE_NEVER;
+      }
+    double ms = t.stop();
+    return (static_cast<double>(rounds) * n) / (ms * 1000000.0);
+  }
+
+}
+
+int
+main(int argc, char* argv[]) {
+  unsigned long int total = 1UL << 26;
+  if (argc > 1)
+    total = static_cast<unsigned long int>(atol(argv[1]));
+
+  const BitSetKernels& scalar = BitSetKernels::scalar();
+  const BitSetKernels& best = BitSetKernels::best();
+  std::cout << "Kernels selected: " << best.name << std::endl
+            << "Throughput in words/ns (speedup over scalar)" << std::endl
+            << std::endl;
+
+  const unsigned int sizes[] = {16U, 256U, 4096U, 65536U};
+  const Operation ops[] = {OP_INTER, OP_UNITE, OP_MINUS, OP_COUNT, OP_FIND};
+
+  std::cout << std::setw(8) << "words";
+  for (unsigned int j=0; j<sizeof(ops)/sizeof(Operation); j++)
+    std::cout << std::setw(18) << name(ops[j]);
+  std::cout << std::endl;
+
+  RandomGenerator r(1U);
+  for (unsigned int i=0; i<sizeof(sizes)/sizeof(unsigned int); i++) {
+    unsigned int n = sizes[i];
+    BitSetData* s = heap.alloc<BitSetData>(n);
+    BitSetData* d = heap.alloc<BitSetData>(n);
+    std::cout << std::setw(8) << n;
+    for (unsigned int j=0; j<sizeof(ops)/sizeof(Operation); j++) {
+      double tp[2];
+      for (int b=0; b<2; b++) {
+        for (unsigned int w=0; w<n; w++) {
+          s[w].init(r(2U) == 1U);
+          // Keep the destination non-empty for and, empty for find
+          d[w].init(ops[j] != OP_FIND);
+        }
+        tp[b] = measure((b == 0) ? scalar : best, ops[j], d, s, n,
+                        total);
+      }
+      std::cout << std::setw(8) << std::fixed << std::setprecision(2)
+                << tp[1] << " (" << std::setw(5) << tp[1]/tp[0] << "x)";
+    }
+    std::cout << std::endl;
+    heap.free<BitSetData>(s,n);
+    heap.free<BitSetData>(d,n);
+  }
+  return 0;
+}
+
+// STATISTICS: test-core
@@ -0,0 +1,162 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/support.hh>
+
+#include "test/test.hh"
+
+namespace Test {
+
+  /// %Test for bitsets and bitset word kernels
+  class BitSet : public Test::Base {
+  protected:
+    /// Bitset type used for testing
+    typedef Gecode::Support::BitSetBase BS;
+    /// Sizes of bitsets to test
+    static const unsigned int n_sizes = 6;
+    /// Return size of bitset for \a i
+    static unsigned int size(unsigned int i) {
+      const unsigned int sizes[n_sizes] = {1U, 63U, 64U, 500U, 1025U, 4711U};
+      return sizes[i];
+    }
+    /// Initialize \a bs with random bits
+    void random(BS& bs, unsigned int p) {
+      for (unsigned int i=0; i<bs.size(); i++)
+        if (Base::rand(p) == 0U)
+          bs.set(i);
+        else
+          bs.clear(i);
+    }
+    /// Test whether kernels \a k yield the same results as scalar kernels
+    bool kernels(const Gecode::Support::BitSetKernels& k, unsigned int n) {
+      using namespace Gecode::Support;
+      const BitSetKernels& s = BitSetKernels::scalar();
+      BitSetData* a = Gecode::heap.alloc<BitSetData>(n);
+      BitSetData* b = Gecode::heap.alloc<BitSetData>(n);
+      BitSetData* c = Gecode::heap.alloc<BitSetData>(n);
+      bool ok = true;
+      for (unsigned int i=0; i<n; i++) {
+        a[i].init(Base::rand(2U) == 0U); b[i].init(Base::rand(3U) == 0U);
+        if (Base::rand(2U) == 0U)
+          a[i].clear(Base::rand(BitSetData::bpb));
+      }
+      BitSetKernels::Binary kb[3] = {k.inter, k.unite, k.minus};
+      BitSetKernels::Binary sb[3] = {s.inter, s.unite, s.minus};
+      for (int o=0; o<3; o++) {
+        for (unsigned int i=0; i<n; i++)
+          c[i] = a[i];
+        kb[o](c,b,n);
+        sb[o](a,b,n);
+        for (unsigned int i=0; i<n; i++)
+          if (!c[i].same(a[i]))
+            ok = false;
+      }
+      if (k.count(a,n) != s.count(a,n))
+        ok = false;
+      for (unsigned int i=0; i<n; i++)
+        c[i].init(false);
+      if (n > 0) {
+        unsigned int f = Base::rand(n);
+        c[f].set(Base::rand(BitSetData::bpb));
+        for (unsigned int i=0; i<=f; i++)
+          if (k.find(c,i,n) != f)
+            ok = false;
+        if (k.find(c,f+1,n) != n)
+          ok = false;
+      }
+      Gecode::heap.free<BitSetData>(a,n);
+      Gecode::heap.free<BitSetData>(b,n);
+      Gecode::heap.free<BitSetData>(c,n);
+      return ok;
+    }
+  public:
+    /// Initialize test
+    BitSet(void) : Test::Base("BitSet") {}
+    /// Perform actual tests
+    bool run(void) {
+      using namespace Gecode::Support;
+      // Kernels for different numbers of words
+      for (unsigned int n=0; n<80; n++)
+        if (!kernels(BitSetKernels::best(),n))
+          return false;
+      // Bulk operations on bitsets
+      for (unsigned int i=0; i<n_sizes; i++) {
+        unsigned int n = size(i);
+        BS a(Gecode::heap,n), b(Gecode::heap,n), c(Gecode::heap,n);
+        random(a,2U); random(b,3U);
+        unsigned int m = 0;
+        for (unsigned int j=0; j<n; j++)
+          if (a.get(j))
+            m++;
+        if (a.count() != m)
+          return false;
+        c.copy(a); c.inter(b);
+        for (unsigned int j=0; j<n; j++)
+          if (c.get(j) != (a.get(j) && b.get(j)))
+            return false;
+        c.copy(a); c.unite(b);
+        for (unsigned int j=0; j<n; j++)
+          if (c.get(j) != (a.get(j) || b.get(j)))
+            return false;
+        c.copy(a); c.minus(b);
+        for (unsigned int j=0; j<n; j++)
+          if (c.get(j) != (a.get(j) && !b.get(j)))
+            return false;
+        // Scanning for set bits (including long runs of cleared bits)
+        random(c,(i % 2 == 0) ? 2U : 200U);
+        unsigned int k = c.next(0);
+        for (unsigned int j=0; j<n; j++)
+          if (c.get(j)) {
+            if (k != j)
+              return false;
+            k = c.next(j+1);
+          }
+        if (k != n)
+          return false;
+        a.dispose(Gecode::heap);
+        b.dispose(Gecode::heap);
+        c.dispose(Gecode::heap);
+      }
+      return true;
+    }
+  };
+
+  BitSet bs;
+
+}
+
+// STATISTICS: test-core
@@ -441,6 +441,55 @@ namespace Test { namespace Int {
        }
      };
 
+     /// %Test for database of clauses
+     class Clauses : public Test {
+     protected:
+       /// The clauses in DIMACS format
+       Gecode::IntArgs c;
+     public:
+       /// Construct and register test
+       Clauses(int n, int m, int l, unsigned int s, bool learn)
+         : Test(std::string("Bool::Clauses::")+(learn ? "Learn::" : "")+
+                str(n)+"::"+str(m)+"::"+str(l)+"::"+
+                str(static_cast<int>(s)),n,0,1,false,
+                learn ? Gecode::IPL_ADVANCED : Gecode::IPL_DEF) {
+         // Simple linear congruential generator for the literals
+         for (int i=0; i<m; i++) {
+           s = s * 1103515245U + 12345U;
+           int k = 1 + static_cast<int>((s >> 16) % l);
+           for (int j=0; j<k; j++) {
+             s = s * 1103515245U + 12345U;
+             int v = 1 + static_cast<int>((s >> 16) % n);
+             c << (((s >> 8) & 1) ? v : -v);
+           }
+           c << 0;
+         }
+       }
+       /// Check whether \a x is solution
+       virtual bool solution(const Assignment& x) const {
+         bool b = false;
+         for (int i=0; i<c.size(); i++)
+           if (c[i] == 0) {
+             if (!b)
+               return false;
+             b = false;
+           } else if (c[i] > 0) {
+             b = b || (x[c[i]-1] == 1);
+           } else {
+             b = b || (x[-c[i]-1] == 0);
+           }
+         return true;
+       }
+       /// Post constraint
+       virtual void post(Gecode::Space& home, Gecode::IntVarArray& x) {
+         using namespace Gecode;
+         BoolVarArgs b(x.size());
+         for (int i=x.size(); i--; )
+           b[i]=channel(home,x[i]);
+         clauses(home, b, c, ipl);
+       }
+     };
+
      /// %Test for if-the-else-constraint
      class ITE : public Test {
      public:
@@ -516,6 +565,16 @@ namespace Test { namespace Int {
      };
 
      Create c;
+     Clauses clauses_3_4_2(3,4,2,1U,false);
+     Clauses clauses_4_6_3(4,6,3,2U,false);
+     Clauses clauses_6_8_3(6,8,3,3U,false);
+     Clauses clauses_6_12_4(6,12,4,4U,false);
+     Clauses clauses_8_16_3(8,16,3,5U,false);
+     Clauses clauses_8_10_6(8,10,6,6U,false);
+     Clauses clauses_learn_6_12_4(6,12,4,4U,true);
+     Clauses clauses_learn_8_16_3(8,16,3,5U,true);
+     Clauses clauses_learn_10_24_3(10,24,3,7U,true);
+     Clauses clauses_learn_10_40_3(10,40,3,8U,true);
      ITE itebnd(Gecode::IPL_BND);
      ITE itedom(Gecode::IPL_DOM);
 
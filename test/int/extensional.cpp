@@ -473,6 +473,46 @@ namespace Test { namespace Int {
 
 
 
+     /// %Test with large tuple set
+     class TupleSetLarge : public Test {
+       mutable Gecode::TupleSet t;
+     public:
+       /// Create and register test
+       TupleSetLarge(Gecode::IntPropLevel ipl0, double prob)
+         : Test("Extensional::TupleSet::Large::"+str(ipl0),
+                5,1,5,false,ipl0) {
+         using namespace Gecode;
+
+         CpltAssignment ass(5, IntSet(1, 5));
+         while (ass()) {
+           if (Base::rand(100) <= prob*100) {
+             IntArgs tuple(5);
+             for (int i = 5; i--; ) tuple[i] = ass[i];
+             t.add(tuple);
+           }
+           ++ass;
+         }
+         t.finalize();
+       }
+       /// %Test whether \a x is solution
+       virtual bool solution(const Assignment& x) const {
+         using namespace Gecode;
+         for (int i = 0; i < t.tuples(); ++i) {
+           TupleSet::Tuple l = t[i];
+           bool same = true;
+           for (int j = 0; j < t.arity() && same; ++j)
+             if (l[j] != x[j]) same = false;
+           if (same) return true;
+         }
+         return false;
+       }
+       /// Post constraint on \a x
+       virtual void post(Gecode::Space& home, Gecode::IntVarArray& x) {
+         using namespace Gecode;
+         extensional(home, x, t, ipl);
+       }
+     };
+
      /// %Test with bool tuple set
      class TupleSetBool : public Test {
        mutable Gecode::TupleSet t;
@@ -547,12 +587,19 @@ namespace Test { namespace Int {
 
      TupleSetA tsam(Gecode::IPL_MEMORY);
      TupleSetA tsas(Gecode::IPL_SPEED);
+     TupleSetA tsaa(Gecode::IPL_ADVANCED);
 
      TupleSetB tsbm(Gecode::IPL_MEMORY);
      TupleSetB tsbs(Gecode::IPL_SPEED);
+     TupleSetB tsba(Gecode::IPL_ADVANCED);
+
+     TupleSetLarge tslm(Gecode::IPL_MEMORY, 0.1);
+     TupleSetLarge tsls(Gecode::IPL_SPEED, 0.1);
+     TupleSetLarge tsld(Gecode::IPL_DEF, 0.1);
 
      TupleSetBool tsboolm(Gecode::IPL_MEMORY, 0.3);
      TupleSetBool tsbools(Gecode::IPL_SPEED, 0.3);
+     TupleSetBool tsboola(Gecode::IPL_ADVANCED, 0.3);
      //@}
 
    }
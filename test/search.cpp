@@ -37,6 +37,8 @@
 
 #include <gecode/minimodel.hh>
 #include <gecode/search.hh>
+#include <climits>
+#include <vector>
 
 #include "test/test.hh"
 
@@ -312,6 +314,35 @@ namespace Test {
       }
     };
 
+    /// Space with integer cost to be minimized or maximized
+    template<class Optimize>
+    class HasCost : public Optimize {
+    public:
+      /// Variables used
+      IntVarArray x;
+      /// Cost variable
+      IntVar c;
+      /// Constructor for space creation
+      HasCost(void) : x(*this,6,0,5), c(*this,-30,30) {
+        distinct(*this, x);
+        rel(*this, x[0]+2*x[1]-x[2]+x[3]-3*x[4]+x[5] == c);
+        branch(*this, x, INT_VAR_NONE(), INT_VAL_MIN());
+      }
+      /// Constructor for cloning \a s
+      HasCost(bool share, HasCost& s) : Optimize(share,s) {
+        x.update(*this, share, s.x);
+        c.update(*this, share, s.c);
+      }
+      /// Copy during cloning
+      virtual Space* copy(bool share) {
+        return new HasCost(share,*this);
+      }
+      /// Return cost
+      virtual IntVar cost(void) const {
+        return c;
+      }
+    };
+
     /// %Base class for search tests
     class Test : public Base {
     public:
@@ -438,6 +469,45 @@ namespace Test {
       }
     };
 
+    /// %Test that parallel limited discrepancy search preserves the order
+    class LDSOrder : public Test {
+    private:
+      /// Number of threads
+      unsigned int t;
+    public:
+      /// Initialize test
+      LDSOrder(HowToBranch htb1, HowToBranch htb2, HowToBranch htb3,
+               unsigned int t0)
+        : Test("LDS::Order::"+
+               str(htb1)+"::"+str(htb2)+"::"+str(htb3)+"::"+str(t0),
+               htb1,htb2,htb3), t(t0) {}
+      /// Run test
+      virtual bool run(void) {
+        HasSolutions* m = new HasSolutions(htb1,htb2,htb3);
+        Gecode::Search::Options o;
+        o.d_l = 50;
+        Gecode::LDS<HasSolutions> s_lds(m,o);
+        o.threads = t;
+        Gecode::LDS<HasSolutions> p_lds(m,o);
+        delete m;
+        while (true) {
+          HasSolutions* s = s_lds.next();
+          HasSolutions* p = p_lds.next();
+          if ((s == NULL) || (p == NULL)) {
+            bool ok = (s == NULL) && (p == NULL);
+            delete s; delete p;
+            return ok;
+          }
+          for (int i=0; i<s->x.size(); i++)
+            if (s->x[i].val() != p->x[i].val()) {
+              delete s; delete p;
+              return false;
+            }
+          delete s; delete p;
+        }
+      }
+    };
+
     /// %Test for best solution search
     template<class Model>
     class BAB : public Test {
@@ -484,6 +554,310 @@ namespace Test {
       }
     };
 
+    /// %Test for parallel best solution search with an integer objective
+    template<class Optimize>
+    class Objective : public Test {
+    private:
+      /// Number of threads
+      unsigned int t;
+    public:
+      /// Initialize test
+      Objective(const std::string& e, unsigned int t0)
+        : Test("BAB::Objective::"+e+"::"+str(t0),
+               HTB_BINARY,HTB_BINARY,HTB_BINARY), t(t0) {}
+      /// Run test
+      virtual bool run(void) {
+        HasCost<Optimize>* m = new HasCost<Optimize>;
+        // Find objective value of best solution sequentially
+        int best;
+        {
+          Gecode::BAB<HasCost<Optimize> > bab(m);
+          HasCost<Optimize>* b = NULL;
+          while (HasCost<Optimize>* s = bab.next()) {
+            delete b; b=s;
+          }
+          if ((b == NULL) || !b->objective(best)) {
+            delete b; delete m;
+            return false;
+          }
+          delete b;
+        }
+        Gecode::Search::FailStop f(2);
+        Gecode::Search::Options o;
+        o.threads = t;
+        o.stop = &f;
+        Gecode::BAB<HasCost<Optimize> > bab(m,o);
+        delete m;
+        // Solutions must have strictly decreasing objective values
+        int last = INT_MAX;
+        while (true) {
+          HasCost<Optimize>* s = bab.next();
+          if (s != NULL) {
+            int v;
+            bool ok = s->objective(v) && (v < last);
+            delete s;
+            if (!ok)
+              return false;
+            last = v;
+          }
+          if ((s == NULL) && !bab.stopped())
+            break;
+          f.limit(f.limit()+2);
+        }
+        return last == best;
+      }
+    };
+
+    /// %Test for deterministic parallel search
+    template<class Optimize>
+    class Deterministic : public Test {
+    private:
+      /// Number of threads
+      unsigned int t;
+      /// Whether best solution search is performed
+      bool b;
+      /// Run search for \a m, record solutions in \a v and objective in \a c
+      template<class Engine>
+      Gecode::Search::Statistics
+      search(HasCost<Optimize>* m, std::vector<int>& v, int& c) {
+        Gecode::Search::Options o;
+        o.threads = t;
+        o.deterministic = true;
+        Engine e(m,o);
+        while (HasCost<Optimize>* s = e.next()) {
+          for (int i=0; i<s->x.size(); i++)
+            v.push_back(s->x[i].val());
+          (void) s->objective(c);
+          delete s;
+        }
+        return e.statistics();
+      }
+    public:
+      /// Initialize test
+      Deterministic(const std::string& e, unsigned int t0, bool b0)
+        : Test("Deterministic::"+std::string(b0 ? "BAB" : "DFS")+"::"+
+               e+"::"+str(t0),
+               HTB_BINARY,HTB_BINARY,HTB_BINARY), t(t0), b(b0) {}
+      /// Run test
+      virtual bool run(void) {
+        typedef Gecode::DFS<HasCost<Optimize> > DFS;
+        typedef Gecode::BAB<HasCost<Optimize> > BAB;
+        HasCost<Optimize>* m = new HasCost<Optimize>;
+        // Two runs must find the same solutions in the same order
+        std::vector<int> v1, v2;
+        int c1 = INT_MAX, c2 = INT_MAX;
+        Gecode::Search::Statistics s1 =
+          b ? search<BAB>(m,v1,c1) : search<DFS>(m,v1,c1);
+        Gecode::Search::Statistics s2 =
+          b ? search<BAB>(m,v2,c2) : search<DFS>(m,v2,c2);
+        if ((v1 != v2) || (c1 != c2) ||
+            (s1.node != s2.node) || (s1.fail != s2.fail)) {
+          delete m;
+          return false;
+        }
+        if (!b) {
+          delete m;
+          // All permutations are solutions
+          return v1.size() == 6*720;
+        }
+        // Compare with the best solution found sequentially
+        int best = INT_MAX;
+        {
+          Gecode::Search::Options o;
+          BAB e(m,o);
+          while (HasCost<Optimize>* s = e.next()) {
+            (void) s->objective(best);
+            delete s;
+          }
+        }
+        delete m;
+        return c1 == best;
+      }
+    };
+
+    /// %Test for checkpointing and restoring search engines
+    template<class Model, template<class> class Engine>
+    class Checkpoint : public Test {
+    private:
+      /// Minimal recomputation distance
+      unsigned int c_d;
+      /// Adaptive recomputation distance
+      unsigned int a_d;
+    public:
+      /// Initialize test
+      Checkpoint(const std::string& e, HowToConstrain htc,
+                 HowToBranch htb1, HowToBranch htb2, HowToBranch htb3,
+                 unsigned int c_d0, unsigned int a_d0)
+        : Test("Checkpoint::"+e+"::"+Model::name()+"::"+str(htc)+"::"+
+               str(htb1)+"::"+str(htb2)+"::"+str(htb3)+"::"+
+               str(c_d0)+"::"+str(a_d0),
+               htb1,htb2,htb3,htc), c_d(c_d0), a_d(a_d0) {}
+      /// Run test
+      virtual bool run(void) {
+        Model* m = new Model(htb1,htb2,htb3,htc);
+        Gecode::Search::FailStop f(2);
+        Gecode::Search::Options o;
+        o.c_d = c_d;
+        o.a_d = a_d;
+        o.threads = 1;
+        o.stop = &f;
+        Engine<Model>* e = new Engine<Model>(m,o);
+        int n = m->solutions();
+        Model* b = NULL;
+        while (true) {
+          Model* s = e->next();
+          if (s != NULL) {
+            n--; delete b; b=s;
+          }
+          if ((s == NULL) && !e->stopped())
+            break;
+          // Continue with a new engine restored from a checkpoint
+          std::stringstream ss;
+          {
+            Gecode::Archive a;
+            e->checkpoint(a);
+            a.write(ss);
+          }
+          delete e;
+          Gecode::Archive a;
+          if (!a.read(ss)) {
+            delete b; delete m;
+            return false;
+          }
+          e = new Engine<Model>(m,o);
+          if (Model* r = e->restore(a)) {
+            delete b; b=r;
+          }
+          f.limit(f.limit()+2);
+        }
+        delete e;
+        delete m;
+        bool ok = Engine<Model>::best ? ((b == NULL) || b->best()) : (n == 0);
+        delete b;
+        return ok;
+      }
+    };
+
+    /// %Test for distributed search
+    template<class Model, template<class> class Engine>
+    class Distributed : public Test {
+    private:
+      /// Number of workers
+      unsigned int t;
+    public:
+      /// Initialize test
+      Distributed(const std::string& e, HowToConstrain htc,
+                  HowToBranch htb1, HowToBranch htb2, HowToBranch htb3,
+                  unsigned int t0)
+        : Test("Distributed::"+e+"::"+Model::name()+"::"+str(htc)+"::"+
+               str(htb1)+"::"+str(htb2)+"::"+str(htb3)+"::"+str(t0),
+               htb1,htb2,htb3,htc), t(t0) {}
+      /// Run test
+      virtual bool run(void) {
+        Model* m = new Model(htb1,htb2,htb3,htc);
+        Gecode::Search::FailStop f(2);
+        Gecode::Search::Options o;
+        o.threads = t;
+        o.stop = &f;
+        Gecode::Distributed<Model,Engine> e(m,o);
+        int n = m->solutions();
+        delete m;
+        Model* b = NULL;
+        while (true) {
+          Model* s = e.next();
+          if (s != NULL) {
+            n--; delete b; b=s;
+          }
+          if ((s == NULL) && !e.stopped())
+            break;
+          f.limit(f.limit()+2);
+        }
+        bool ok = Engine<Model>::best ? ((b == NULL) || b->best()) : (n == 0);
+        delete b;
+        return ok;
+      }
+    };
+
+    /// %Test for embarrassingly parallel search
+    template<class Model, template<class> class Engine>
+    class EPS : public Test {
+    private:
+      /// Number of threads
+      unsigned int t;
+    public:
+      /// Initialize test
+      EPS(const std::string& e, HowToConstrain htc,
+          HowToBranch htb1, HowToBranch htb2, HowToBranch htb3,
+          unsigned int t0)
+        : Test("EPS::"+e+"::"+Model::name()+"::"+str(htc)+"::"+
+               str(htb1)+"::"+str(htb2)+"::"+str(htb3)+"::"+str(t0),
+               htb1,htb2,htb3,htc), t(t0) {}
+      /// Run test
+      virtual bool run(void) {
+        Model* m = new Model(htb1,htb2,htb3,htc);
+        Gecode::Search::FailStop f(2);
+        Gecode::Search::Options o;
+        o.threads = t;
+        o.stop = &f;
+        Gecode::EPS<Model,Engine> e(m,o);
+        int n = m->solutions();
+        delete m;
+        Model* b = NULL;
+        while (true) {
+          Model* s = e.next();
+          if (s != NULL) {
+            n--; delete b; b=s;
+          }
+          if ((s == NULL) && !e.stopped())
+            break;
+          f.limit(f.limit()+2);
+        }
+        bool ok = Engine<Model>::best ? ((b == NULL) || b->best()) : (n == 0);
+        delete b;
+        return ok;
+      }
+    };
+
+    /// %Test for embarrassingly parallel search in a portfolio
+    template<class Model, template<class> class Engine>
+    class EPSPBS : public Test {
+    private:
+      /// Number of threads
+      unsigned int t;
+    public:
+      /// Initialize test
+      EPSPBS(const std::string& e, unsigned int t0)
+        : Test("PBS::EPS::"+e+"::"+Model::name()+"::"+str(t0),
+               HTB_BINARY,HTB_BINARY,HTB_BINARY), t(t0) {}
+      /// Run test
+      virtual bool run(void) {
+        Model* m = new Model(htb1,htb2,htb3);
+        Gecode::Search::FailStop f(2);
+        Gecode::Search::Options o;
+        o.threads = t;
+        o.stop = &f;
+        SEBs sebs(2);
+        sebs[0] = eps<Model,Engine>(o);
+        sebs[1] = eps<Model,Engine>(o);
+        Gecode::PBS<Model,Engine> pbs(m, sebs, o);
+        int n = 2 * m->solutions();
+        delete m;
+        Model* b = NULL;
+        while (true) {
+          Model* s = pbs.next();
+          if (s != NULL) {
+            n--; delete b; b=s;
+          }
+          if ((s == NULL) && !pbs.stopped())
+            break;
+          f.limit(f.limit()+2);
+        }
+        bool ok = Engine<Model>::best ? ((b == NULL) || b->best()) : (n == 0);
+        delete b;
+        return ok;
+      }
+    };
+
     /// %Test for restart-based search
     template<class Model, template<class> class Engine>
     class RBS : public Test {
@@ -726,6 +1100,20 @@ namespace Test {
               new DFS<HasSolutions>(HTB_NONE, HTB_NONE, HTB_NONE,
                                     c_d, a_d, t);
             }
+        // Depth-first search with adaptive distances
+        for (unsigned int t = 1; t<=4; t++) {
+          unsigned int c_d = Gecode::Search::Config::c_d_auto;
+          unsigned int a_d = Gecode::Search::Config::a_d;
+          for (BranchTypes htb1; htb1(); ++htb1)
+            for (BranchTypes htb2; htb2(); ++htb2)
+              for (BranchTypes htb3; htb3(); ++htb3)
+                (void) new DFS<HasSolutions>
+                  (htb1.htb(),htb2.htb(),htb3.htb(),c_d, a_d, t);
+          new DFS<FailImmediate>(HTB_NONE, HTB_NONE, HTB_NONE,
+                                 c_d, a_d, t);
+          new DFS<SolveImmediate>(HTB_NONE, HTB_NONE, HTB_NONE,
+                                  c_d, a_d, t);
+        }
 
         // Limited discrepancy search
         for (unsigned int t = 1; t<=4; t++) {
@@ -737,6 +1125,11 @@ namespace Test {
           new LDS<FailImmediate>(HTB_NONE, HTB_NONE, HTB_NONE, t);
           new LDS<HasSolutions>(HTB_NONE, HTB_NONE, HTB_NONE, t);
         }
+        for (unsigned int t = 2; t<=4; t++)
+          for (BranchTypes htb1; htb1(); ++htb1)
+            for (BranchTypes htb2; htb2(); ++htb2)
+              for (BranchTypes htb3; htb3(); ++htb3)
+                (void) new LDSOrder(htb1.htb(),htb2.htb(),htb3.htb(),t);
 
         // Best solution search
         for (unsigned int t = 1; t<=4; t++)
@@ -757,6 +1150,102 @@ namespace Test {
               (void) new BAB<HasSolutions>
                 (HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,c_d,a_d,t);
             }
+        // Best solution search with an integer objective
+        for (unsigned int t = 1; t<=4; t++) {
+          (void) new Objective<IntMinimizeSpace>("Min",t);
+          (void) new Objective<IntMaximizeSpace>("Max",t);
+        }
+        // Deterministic parallel search
+        for (unsigned int t = 2; t<=4; t++) {
+          (void) new Deterministic<IntMinimizeSpace>("Min",t,false);
+          (void) new Deterministic<IntMinimizeSpace>("Min",t,true);
+          (void) new Deterministic<IntMaximizeSpace>("Max",t,true);
+        }
+        // Best solution search with adaptive distances
+        for (unsigned int t = 1; t<=4; t++) {
+          unsigned int c_d = Gecode::Search::Config::c_d_auto;
+          unsigned int a_d = Gecode::Search::Config::a_d;
+          for (ConstrainTypes htc; htc(); ++htc)
+            for (BranchTypes htb1; htb1(); ++htb1)
+              for (BranchTypes htb2; htb2(); ++htb2)
+                for (BranchTypes htb3; htb3(); ++htb3)
+                  (void) new BAB<HasSolutions>
+                    (htc.htc(),htb1.htb(),htb2.htb(),htb3.htb(),
+                     c_d,a_d,t);
+          (void) new BAB<FailImmediate>
+            (HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,c_d,a_d,t);
+          (void) new BAB<SolveImmediate>
+            (HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,c_d,a_d,t);
+        }
+        // Checkpointing
+        for (unsigned int c_d = 1; c_d<10; c_d += 4)
+          for (unsigned int a_d = 1; a_d<=c_d; a_d += 4) {
+            for (BranchTypes htb1; htb1(); ++htb1)
+              for (BranchTypes htb2; htb2(); ++htb2)
+                for (BranchTypes htb3; htb3(); ++htb3) {
+                  (void) new Checkpoint<HasSolutions,Gecode::DFS>
+                    ("DFS",HTC_NONE,htb1.htb(),htb2.htb(),htb3.htb(),
+                     c_d,a_d);
+                  for (ConstrainTypes htc; htc(); ++htc)
+                    (void) new Checkpoint<HasSolutions,Gecode::BAB>
+                      ("BAB",htc.htc(),htb1.htb(),htb2.htb(),htb3.htb(),
+                       c_d,a_d);
+                }
+            (void) new Checkpoint<FailImmediate,Gecode::DFS>
+              ("DFS",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,c_d,a_d);
+            (void) new Checkpoint<SolveImmediate,Gecode::DFS>
+              ("DFS",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,c_d,a_d);
+            (void) new Checkpoint<FailImmediate,Gecode::BAB>
+              ("BAB",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,c_d,a_d);
+            (void) new Checkpoint<SolveImmediate,Gecode::BAB>
+              ("BAB",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,c_d,a_d);
+          }
+        // Distributed search
+        for (unsigned int t=1; t<=3; t++) {
+          for (BranchTypes htb1; htb1(); ++htb1)
+            for (BranchTypes htb2; htb2(); ++htb2)
+              for (BranchTypes htb3; htb3(); ++htb3) {
+                (void) new Distributed<HasSolutions,Gecode::DFS>
+                  ("DFS",HTC_NONE,htb1.htb(),htb2.htb(),htb3.htb(),t);
+                for (ConstrainTypes htc; htc(); ++htc)
+                  (void) new Distributed<HasSolutions,Gecode::BAB>
+                    ("BAB",htc.htc(),htb1.htb(),htb2.htb(),htb3.htb(),t);
+              }
+          (void) new Distributed<FailImmediate,Gecode::DFS>
+            ("DFS",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+          (void) new Distributed<SolveImmediate,Gecode::DFS>
+            ("DFS",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+          (void) new Distributed<FailImmediate,Gecode::BAB>
+            ("BAB",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+          (void) new Distributed<SolveImmediate,Gecode::BAB>
+            ("BAB",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+        }
+        // Embarrassingly parallel search
+        for (unsigned int t=1; t<=4; t++) {
+          for (BranchTypes htb1; htb1(); ++htb1)
+            for (BranchTypes htb2; htb2(); ++htb2)
+              for (BranchTypes htb3; htb3(); ++htb3) {
+                (void) new EPS<HasSolutions,Gecode::DFS>
+                  ("DFS",HTC_NONE,htb1.htb(),htb2.htb(),htb3.htb(),t);
+                // Balance has ties: subproblems might find any of them first
+                for (ConstrainTypes htc; htc(); ++htc)
+                  if ((htc.htc() == HTC_LEX_LE) || (htc.htc() == HTC_LEX_GR))
+                    (void) new EPS<HasSolutions,Gecode::BAB>
+                      ("BAB",htc.htc(),htb1.htb(),htb2.htb(),htb3.htb(),t);
+              }
+          (void) new EPS<FailImmediate,Gecode::DFS>
+            ("DFS",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+          (void) new EPS<SolveImmediate,Gecode::DFS>
+            ("DFS",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+          (void) new EPS<FailImmediate,Gecode::BAB>
+            ("BAB",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+          (void) new EPS<SolveImmediate,Gecode::BAB>
+            ("BAB",HTC_NONE,HTB_NONE,HTB_NONE,HTB_NONE,t);
+          (void) new EPSPBS<HasSolutions,Gecode::DFS>("DFS",t);
+          (void) new EPSPBS<HasSolutions,Gecode::BAB>("BAB",t);
+          (void) new EPSPBS<FailImmediate,Gecode::DFS>("DFS",t);
+          (void) new EPSPBS<SolveImmediate,Gecode::BAB>("BAB",t);
+        }
         // Restart-based search
         for (unsigned int t=1; t<=4; t++) {
           (void) new RBS<HasSolutions,Gecode::DFS>("DFS",t);
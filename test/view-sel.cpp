@@ -0,0 +1,197 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main author:
+ *     Christian Schulte <schulte@gecode.org>
+ *
+ *  Copyright:
+ *     Christian Schulte, 2017
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of Gecode, the generic constraint
+ *  development environment:
+ *     http://www.gecode.org
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <gecode/int.hh>
+#include <gecode/search.hh>
+
+#include "test/test.hh"
+
+namespace Test {
+
+  /// Tests for view selection
+  namespace ViewSel {
+
+    /// Merit functions that agree with the built-in merits
+    class Merit {
+    public:
+      /// Size
+      static double size(const Gecode::Space&, Gecode::IntVar x, int) {
+        return x.size();
+      }
+      /// Minimum
+      static double min(const Gecode::Space&, Gecode::IntVar x, int) {
+        return x.min();
+      }
+      /// Maximum
+      static double max(const Gecode::Space&, Gecode::IntVar x, int) {
+        return x.max();
+      }
+      /// Smallest regret
+      static double regret_min(const Gecode::Space&, Gecode::IntVar x, int) {
+        return x.regret_min();
+      }
+      /// Largest regret
+      static double regret_max(const Gecode::Space&, Gecode::IntVar x, int) {
+        return x.regret_max();
+      }
+    };
+
+    /// Test space
+    class TestSpace : public Gecode::Space {
+    public:
+      /// Integer variables
+      Gecode::IntVarArray x;
+      /// Constructor for creation
+      TestSpace(const Gecode::IntArgs& d) : x(*this,d.size()) {
+        using namespace Gecode;
+        for (int i=0; i<x.size(); i++)
+          x[i] = IntVar(*this,0,d[i]);
+        for (int i=0; i+3<x.size(); i+=3)
+          distinct(*this, x.slice(i,1,4));
+        linear(*this, x, IRT_EQ, 2*x.size());
+      }
+      /// Constructor for cloning \a s
+      TestSpace(bool share, TestSpace& s) : Space(share,s) {
+        x.update(*this,share,s.x);
+      }
+      /// Copy during cloning
+      virtual Space* copy(bool share) {
+        return new TestSpace(share,*this);
+      }
+    };
+
+    /**
+     * \brief %Test for heap-based view selection
+     *
+     * Compares the search trees obtained from built-in merits (using a
+     * heap for large arrays) and merit functions (always scanning the
+     * views) for the same merit.
+     */
+    class Heap : public Test::Base {
+    protected:
+      /// Number of variables
+      static const int n = 400;
+      /// Number of solutions to compare
+      static const int n_sol = 16;
+      /// Maximal number of nodes to explore
+      static const unsigned long int n_node = 4096;
+      /// Built-in view selection
+      Gecode::TieBreak<Gecode::IntVarBranch> h;
+      /// View selection by merit function
+      Gecode::TieBreak<Gecode::IntVarBranch> f;
+      /// Search for solutions with view selection \a vs
+      void search(const Gecode::IntArgs& d,
+                  Gecode::TieBreak<Gecode::IntVarBranch> vs,
+                  int& n, int s[][Heap::n],
+                  Gecode::Search::Statistics& stat) {
+        TestSpace* t = new TestSpace(d);
+        Gecode::branch(*t, t->x, vs, Gecode::INT_VAL_MIN());
+        Gecode::Search::Options o;
+        o.stop = Gecode::Search::Stop::node(n_node);
+        Gecode::DFS<TestSpace> e(t,o);
+        delete t;
+        n = 0;
+        while (n < n_sol) {
+          TestSpace* r = e.next();
+          if (r == NULL)
+            break;
+          for (int i=0; i<Heap::n; i++)
+            s[n][i] = r->x[i].val();
+          n++;
+          delete r;
+        }
+        stat = e.statistics();
+        delete o.stop;
+      }
+    public:
+      /// Create and register test
+      Heap(const std::string& s,
+           Gecode::TieBreak<Gecode::IntVarBranch> h0,
+           Gecode::TieBreak<Gecode::IntVarBranch> f0)
+        : Test::Base("ViewSel::Heap::"+s), h(h0), f(f0) {}
+      /// Perform actual tests
+      bool run(void) {
+        Gecode::IntArgs d(n);
+        for (int i=0; i<n; i++)
+          d[i] = 3 + static_cast<int>(rand(5));
+        int n_h, n_f;
+        int s_h[n_sol][n], s_f[n_sol][n];
+        Gecode::Search::Statistics st_h, st_f;
+        search(d,h,n_h,s_h,st_h);
+        search(d,f,n_f,s_f,st_f);
+        if (n_h != n_f)
+          return false;
+        if ((st_h.node != st_f.node) || (st_h.fail != st_f.fail))
+          return false;
+        for (int j=0; j<n_h; j++)
+          for (int i=0; i<n; i++)
+            if (s_h[j][i] != s_f[j][i])
+              return false;
+        return true;
+      }
+    };
+
+    using namespace Gecode;
+
+    Heap size_min("Size::Min",
+                  INT_VAR_SIZE_MIN(),
+                  INT_VAR_MERIT_MIN(&Merit::size));
+    Heap size_max("Size::Max",
+                  INT_VAR_SIZE_MAX(),
+                  INT_VAR_MERIT_MAX(&Merit::size));
+    Heap min_min("Min::Min",
+                 INT_VAR_MIN_MIN(),
+                 INT_VAR_MERIT_MIN(&Merit::min));
+    Heap max_max("Max::Max",
+                 INT_VAR_MAX_MAX(),
+                 INT_VAR_MERIT_MAX(&Merit::max));
+    Heap regret_min_max("RegretMin::Max",
+                        INT_VAR_REGRET_MIN_MAX(),
+                        INT_VAR_MERIT_MAX(&Merit::regret_min));
+    Heap regret_max_min("RegretMax::Min",
+                        INT_VAR_REGRET_MAX_MIN(),
+                        INT_VAR_MERIT_MIN(&Merit::regret_max));
+    Heap size_min_max_max("Size::Min::Max::Max",
+                          tiebreak(INT_VAR_SIZE_MIN(),INT_VAR_MAX_MAX()),
+                          tiebreak(INT_VAR_MERIT_MIN(&Merit::size),
+                                   INT_VAR_MERIT_MAX(&Merit::max)));
+
+  }
+
+}
+
+// STATISTICS: test-branch